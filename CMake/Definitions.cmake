@@ -14,6 +14,7 @@ foreach(
   GPERF
   GPERF_HEAP_MAIN
   GPERF_HEAP_FIRST_GAME_ITERATION
+  DEVILUTIONX_PROFILER
   PACKET_ENCRYPTION
   DEVILUTIONX_RESAMPLER_SPEEX
   DEVILUTIONX_RESAMPLER_SDL
@@ -21,6 +22,7 @@ foreach(
   SCREEN_READER_INTEGRATION
   UNPACKED_MPQS
   UNPACKED_SAVES
+  MMAP_MPQS
   DEVILUTIONX_WINDOWS_NO_WCHAR
 )
   if(${def_name})
@@ -38,6 +40,10 @@ foreach(
   DEFAULT_AUDIO_BUFFER_SIZE
   DEFAULT_AUDIO_RESAMPLING_QUALITY
   DEFAULT_PER_PIXEL_LIGHTING
+  DEFAULT_PARTIAL_REDRAW
+  DEFAULT_FLOOR_CACHE
+  DEFAULT_SPRITE_CACHE
+  DEFAULT_MPQ_BLOCK_CACHE
   SDL1_VIDEO_MODE_BPP
   SDL1_VIDEO_MODE_FLAGS
   SDL1_VIDEO_MODE_SVID_FLAGS
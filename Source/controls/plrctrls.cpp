@@ -3,7 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <list>
+#include <vector>
 
 #ifdef USE_SDL1
 #include "utils/sdl2_to_1_2_backports.h"
@@ -28,6 +28,7 @@
 #include "hwcursor.hpp"
 #include "inv.h"
 #include "items.h"
+#include "levels/distance_field.hpp"
 #include "levels/tile_properties.hpp"
 #include "levels/town.h"
 #include "levels/trigs.h"
@@ -127,9 +128,13 @@ int GetDistance(Point destination, int maxDistance)
 		return 0;
 	}
 
-	int8_t walkpath[MaxPathLengthPlayer];
 	Player &myPlayer = *MyPlayer;
-	const int steps = FindPath(CanStep, [&myPlayer](Point position) { return PosOkPlayer(myPlayer, position); }, myPlayer.position.future, destination, walkpath, std::min<size_t>(maxDistance, MaxPathLengthPlayer));
+	if (GetWalkingDistanceLowerBound(myPlayer, destination) > maxDistance) {
+		return 0;
+	}
+
+	int8_t walkpath[MaxPathLengthPlayer];
+	const int steps = FindPlayerPath(myPlayer, destination, walkpath, std::min<size_t>(maxDistance, MaxPathLengthPlayer));
 	if (steps > maxDistance)
 		return 0;
 
@@ -284,46 +289,59 @@ void FindRangedTarget()
 	}
 }
 
+struct MeleeSearchNode {
+	int x, y;
+	int steps;
+};
+
+/** Queue of the `FindMeleeTarget` search, kept to reuse its storage. */
+std::vector<MeleeSearchNode> MeleeSearchQueue;
+
+/** Tiles visited by `FindMeleeTarget`, marked with the number of the search so they need not be cleared for every search. */
+uint16_t MeleeSearchVisited[MAXDUNX][MAXDUNY];
+uint16_t MeleeSearchNumber;
+
 void FindMeleeTarget()
 {
-	bool visited[MAXDUNX][MAXDUNY] = { {} };
 	int maxSteps = 25; // Max steps for FindPath is 25
 	int rotations = 0;
 	bool canTalk = false;
 
-	struct SearchNode {
-		int x, y;
-		int steps;
-	};
-	std::list<SearchNode> queue;
+	MeleeSearchNumber++;
+	if (MeleeSearchNumber == 0) {
+		// The marks of earlier searches would be mistaken for visits once the search number wraps around.
+		std::fill(&MeleeSearchVisited[0][0], &MeleeSearchVisited[0][0] + MAXDUNX * MAXDUNY, 0);
+		MeleeSearchNumber = 1;
+	}
+	const auto visit = [](int x, int y) { MeleeSearchVisited[x][y] = MeleeSearchNumber; };
+	MeleeSearchQueue.clear();
 
 	const Player &myPlayer = *MyPlayer;
 
 	{
 		const int startX = myPlayer.position.future.x;
 		const int startY = myPlayer.position.future.y;
-		visited[startX][startY] = true;
-		queue.push_back({ startX, startY, 0 });
+		visit(startX, startY);
+		MeleeSearchQueue.push_back({ startX, startY, 0 });
 	}
 
-	while (!queue.empty()) {
-		const SearchNode node = queue.front();
-		queue.pop_front();
+	for (size_t i = 0; i < MeleeSearchQueue.size(); i++) {
+		const MeleeSearchNode node = MeleeSearchQueue[i];
 
 		for (auto pathDir : PathDirs) {
 			const int dx = node.x + pathDir.deltaX;
 			const int dy = node.y + pathDir.deltaY;
 
-			if (visited[dx][dy])
+			if (MeleeSearchVisited[dx][dy] == MeleeSearchNumber)
 				continue; // already visisted
 
 			if (node.steps > maxSteps) {
-				visited[dx][dy] = true;
+				visit(dx, dy);
 				continue;
 			}
 
 			if (!PosOkPlayer(myPlayer, { dx, dy })) {
-				visited[dx][dy] = true;
+				visit(dx, dy);
 
 				if (dMonster[dx][dy] != 0) {
 					const int mi = std::abs(dMonster[dx][dy]) - 1;
@@ -347,8 +365,8 @@ void FindMeleeTarget()
 			}
 
 			if (CanStep({ node.x, node.y }, { dx, dy })) {
-				queue.push_back({ dx, dy, node.steps + 1 });
-				visited[dx][dy] = true;
+				MeleeSearchQueue.push_back({ dx, dy, node.steps + 1 });
+				visit(dx, dy);
 			}
 		}
 	}
@@ -25,8 +25,10 @@ void InitDeadAnimationFromMonster(Corpse &corpse, const CMonster &mon)
 	const AnimStruct &animData = mon.getAnimData(MonsterGraphic::Death);
 	if (animData.sprites) {
 		corpse.sprites.emplace(*animData.sprites);
+		corpse.trn = mon.getTRN(animData.sprites->isSheet() ? animData.sprites->sheet()[0] : animData.sprites->list());
 	} else {
 		corpse.sprites = std::nullopt;
+		corpse.trn = nullptr;
 	}
 	corpse.frame = animData.frames - 1;
 	corpse.width = animData.width;
@@ -69,6 +71,7 @@ void InitCorpses()
 
 	if (!HeadlessMode)
 		Corpses[nd].sprites.emplace(*GetMissileSpriteData(MissileGraphicID::StoneCurseShatter).sprites);
+	Corpses[nd].trn = nullptr;
 	Corpses[nd].frame = 11;
 	Corpses[nd].width = 128;
 	Corpses[nd].translationPaletteIndex = 0;
@@ -21,6 +21,8 @@ struct Corpse {
 	int frame;
 	uint16_t width;
 	uint8_t translationPaletteIndex;
+	/** @brief Palette translation of the monster type, applied before any other translation or lighting. */
+	const uint8_t *trn;
 
 	/**
 	 * @brief Returns the sprite list for a given direction.
@@ -31,13 +31,16 @@
 #include "discord/discord.h"
 #include "doom.h"
 #include "encrypt.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/backbuffer_state.hpp"
+#include "engine/clx_cache.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/demomode.h"
 #include "engine/dx.h"
 #include "engine/events.hpp"
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
+#include "engine/profiler.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
 #include "engine/sound.h"
@@ -53,11 +56,13 @@
 #include "levels/drlg_l2.h"
 #include "levels/drlg_l3.h"
 #include "levels/drlg_l4.h"
+#include "levels/distance_field.hpp"
 #include "levels/gendung.h"
 #include "levels/setmaps.h"
 #include "levels/themes.h"
 #include "levels/town.h"
 #include "levels/trigs.h"
+#include "levels/walkability.hpp"
 #include "lighting.h"
 #include "loadsave.h"
 #include "lua/lua_global.hpp"
@@ -103,6 +108,10 @@
 #include "utils/str_cat.hpp"
 #include "utils/utf8.hpp"
 
+#ifndef UNPACKED_MPQS
+#include "mpq/mpq_block_cache.hpp"
+#endif
+
 #ifndef USE_SDL1
 #include "controls/touch/gamepad.h"
 #include "controls/touch/renderers.h"
@@ -201,6 +210,7 @@ void FreeGame()
 	FreeDebugGFX();
 #endif
 	FreeGameMem();
+	FreeDungeonMicrosCache();
 	stream_stop();
 	music_stop();
 }
@@ -911,12 +921,15 @@ void RunGameLoop(interface_mode uMsg)
 			continue;
 		}
 
+		demo::NotifyGameTickStart();
 		multi_process_network_packets();
 		if (game_loop(gbGameLoopStartup))
 			diablo_color_cyc_logic();
 		gbGameLoopStartup = false;
+		demo::NotifyGameTickLogicEnd();
 		if (drawGame)
 			DrawAndBlit();
+		demo::NotifyGameTickEnd();
 #ifdef GPERF_HEAP_FIRST_GAME_ITERATION
 		if (run_game_iteration++ == 0)
 			HeapProfilerDump("first_game_iteration");
@@ -979,6 +992,10 @@ void PrintHelpOption(std::string_view flags, std::string_view description)
 	PrintHelpOption("--record <#>", _(/* TRANSLATORS: Commandline Option */ "Record a demo file"));
 	PrintHelpOption("--demo <#>", _(/* TRANSLATORS: Commandline Option */ "Play a demo file"));
 	PrintHelpOption("--timedemo", _(/* TRANSLATORS: Commandline Option */ "Disable all frame limiting during demo playback"));
+	PrintHelpOption("--timedemo-log <path>", _(/* TRANSLATORS: Commandline Option */ "Write the time of each frame of demo playback as JSON"));
+#endif
+#ifdef DEVILUTIONX_PROFILER
+	PrintHelpOption("--trace-out <path>", "Write a Chrome trace of the profiled subsystems");
 #endif
 	printNewlineInConsole();
 	printInConsole(_(/* TRANSLATORS: Commandline Option */ "Game selection:"));
@@ -1021,6 +1038,7 @@ void DiabloParseFlags(int argc, char **argv)
 #endif
 #ifndef DISABLE_DEMOMODE
 	bool timedemo = false;
+	std::string_view timingLogPath;
 	int demoNumber = -1;
 	int recordNumber = -1;
 	bool createDemoReference = false;
@@ -1074,6 +1092,12 @@ void DiabloParseFlags(int argc, char **argv)
 			gbShowIntro = false;
 		} else if (arg == "--timedemo") {
 			timedemo = true;
+		} else if (arg == "--timedemo-log") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--timedemo-log");
+				diablo_quit(64);
+			}
+			timingLogPath = argv[++i];
 		} else if (arg == "--record") {
 			if (i + 1 == argc) {
 				PrintFlagRequiresArgument("--record");
@@ -1088,10 +1112,26 @@ void DiabloParseFlags(int argc, char **argv)
 		} else if (arg == "--create-reference") {
 			createDemoReference = true;
 #else
-		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--record" || arg == "--create-reference") {
+		} else if (arg == "--demo" || arg == "--timedemo" || arg == "--timedemo-log" || arg == "--record" || arg == "--create-reference") {
 			printInConsole("Binary compiled without demo mode support.");
 			printNewlineInConsole();
 			diablo_quit(1);
+#endif
+#ifdef DEVILUTIONX_PROFILER
+		} else if (arg == "--trace-out") {
+			if (i + 1 == argc) {
+				PrintFlagRequiresArgument("--trace-out");
+				diablo_quit(64);
+			}
+			if (!profiler::StartTrace(argv[++i])) {
+				PrintFlagMessage("--trace-out", " could not be opened");
+				diablo_quit(1);
+			}
+#else
+		} else if (arg == "--trace-out") {
+			printInConsole("Binary compiled without profiler support.");
+			printNewlineInConsole();
+			diablo_quit(1);
 #endif
 		} else if (arg == "-n") {
 			gbShowIntro = false;
@@ -1137,6 +1177,8 @@ void DiabloParseFlags(int argc, char **argv)
 #ifndef DISABLE_DEMOMODE
 	if (demoNumber != -1)
 		demo::InitPlayBack(demoNumber, timedemo);
+	if (!timingLogPath.empty())
+		demo::InitTimingLog(timingLogPath);
 	if (recordNumber != -1)
 		demo::InitRecording(recordNumber, createDemoReference);
 #endif
@@ -1275,6 +1317,9 @@ void DiabloSplash()
 
 void DiabloDeinit()
 {
+#ifdef DEVILUTIONX_PROFILER
+	profiler::StopTrace();
+#endif
 	FreeItemGFX();
 
 	LuaShutdown();
@@ -1294,25 +1339,73 @@ void DiabloDeinit()
 		SDL_Quit();
 }
 
+struct LvlGfxPaths {
+	const char *cel;
+	const char *til;
+	const char *special;
+};
+
+/** @brief Returns the tileset paths of a dungeon level type (not including town). */
+std::optional<LvlGfxPaths> GetDungeonLvlGfxPaths(dungeon_type type)
+{
+	switch (type) {
+	case DTYPE_CATHEDRAL:
+		return LvlGfxPaths { "levels\\l1data\\l1.cel", "levels\\l1data\\l1.til", "levels\\l1data\\l1s" };
+	case DTYPE_CATACOMBS:
+		return LvlGfxPaths { "levels\\l2data\\l2.cel", "levels\\l2data\\l2.til", "levels\\l2data\\l2s" };
+	case DTYPE_CAVES:
+		return LvlGfxPaths { "levels\\l3data\\l3.cel", "levels\\l3data\\l3.til", "levels\\l1data\\l1s" };
+	case DTYPE_HELL:
+		return LvlGfxPaths { "levels\\l4data\\l4.cel", "levels\\l4data\\l4.til", "levels\\l2data\\l2s" };
+	case DTYPE_NEST:
+		return LvlGfxPaths { "nlevels\\l6data\\l6.cel", "nlevels\\l6data\\l6.til", "levels\\l1data\\l1s" };
+	case DTYPE_CRYPT:
+		return LvlGfxPaths { "nlevels\\l5data\\l5.cel", "nlevels\\l5data\\l5.til", "nlevels\\l5data\\l5s" };
+	default:
+		return std::nullopt;
+	}
+}
+
+/**
+ * @brief Starts reading the level tileset in the background while the rest of `LoadGameLevel` runs.
+ *
+ * The cels are skipped if they are going to be restored from the dungeon micros cache.
+ */
+void PrefetchLvlGFX()
+{
+	if (HeadlessMode)
+		return;
+
+	const bool prefetchCels = !HasCachedDungeonMicros();
+	std::vector<std::string> paths;
+	if (leveltype == DTYPE_TOWN) {
+		const bool hasHellfireTown = FindAsset("nlevels\\towndata\\town.cel").ok();
+		if (prefetchCels)
+			paths.emplace_back(hasHellfireTown ? "nlevels\\towndata\\town.cel" : "levels\\towndata\\town.cel");
+		paths.emplace_back(hasHellfireTown ? "nlevels\\towndata\\town.til" : "levels\\towndata\\town.til");
+	} else if (const std::optional<LvlGfxPaths> lvlGfxPaths = GetDungeonLvlGfxPaths(leveltype); lvlGfxPaths.has_value()) {
+		if (prefetchCels)
+			paths.emplace_back(lvlGfxPaths->cel);
+		paths.emplace_back(lvlGfxPaths->til);
+	}
+	PrefetchAssets(paths);
+}
+
 tl::expected<void, std::string> LoadLvlGFX()
 {
-	assert(pDungeonCels == nullptr);
+	// The dungeon cels are already set up if they were restored from the cache.
+	const bool loadCels = pDungeonCels == nullptr;
 	constexpr int SpecialCelWidth = 64;
 
-	const auto loadAll = [](const char *cel, const char *til, const char *special) -> tl::expected<void, std::string> {
-		ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus(cel));
-		ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>(til));
-		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus(special, SpecialCelWidth));
-		return {};
-	};
-
 	switch (leveltype) {
 	case DTYPE_TOWN: {
-		auto cel = LoadFileInMemWithStatus("nlevels\\towndata\\town.cel");
-		if (!cel.has_value()) {
-			ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus("levels\\towndata\\town.cel"));
-		} else {
-			pDungeonCels = std::move(*cel);
+		if (loadCels) {
+			auto cel = LoadFileInMemWithStatus("nlevels\\towndata\\town.cel");
+			if (!cel.has_value()) {
+				ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus("levels\\towndata\\town.cel"));
+			} else {
+				pDungeonCels = std::move(*cel);
+			}
 		}
 		auto til = LoadFileInMemWithStatus<MegaTile>("nlevels\\towndata\\town.til");
 		if (!til.has_value()) {
@@ -1323,38 +1416,17 @@ tl::expected<void, std::string> LoadLvlGFX()
 		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus("levels\\towndata\\towns", SpecialCelWidth));
 		return {};
 	}
-	case DTYPE_CATHEDRAL:
-		return loadAll(
-		    "levels\\l1data\\l1.cel",
-		    "levels\\l1data\\l1.til",
-		    "levels\\l1data\\l1s");
-	case DTYPE_CATACOMBS:
-		return loadAll(
-		    "levels\\l2data\\l2.cel",
-		    "levels\\l2data\\l2.til",
-		    "levels\\l2data\\l2s");
-	case DTYPE_CAVES:
-		return loadAll(
-		    "levels\\l3data\\l3.cel",
-		    "levels\\l3data\\l3.til",
-		    "levels\\l1data\\l1s");
-	case DTYPE_HELL:
-		return loadAll(
-		    "levels\\l4data\\l4.cel",
-		    "levels\\l4data\\l4.til",
-		    "levels\\l2data\\l2s");
-	case DTYPE_NEST:
-		return loadAll(
-		    "nlevels\\l6data\\l6.cel",
-		    "nlevels\\l6data\\l6.til",
-		    "levels\\l1data\\l1s");
-	case DTYPE_CRYPT:
-		return loadAll(
-		    "nlevels\\l5data\\l5.cel",
-		    "nlevels\\l5data\\l5.til",
-		    "nlevels\\l5data\\l5s");
-	default:
-		return tl::make_unexpected("LoadLvlGFX");
+	default: {
+		const std::optional<LvlGfxPaths> paths = GetDungeonLvlGfxPaths(leveltype);
+		if (!paths.has_value())
+			return tl::make_unexpected("LoadLvlGFX");
+		if (loadCels) {
+			ASSIGN_OR_RETURN(pDungeonCels, LoadFileInMemWithStatus(paths->cel));
+		}
+		ASSIGN_OR_RETURN(pMegaTiles, LoadFileInMemWithStatus<MegaTile>(paths->til));
+		ASSIGN_OR_RETURN(pSpecialCels, LoadCelWithStatus(paths->special, SpecialCelWidth));
+		return {};
+	}
 	}
 }
 
@@ -1462,6 +1534,8 @@ void GameLogic()
 	if (!ProcessInput()) {
 		return;
 	}
+	InvalidateDistanceFields();
+	InvalidateOccupiedTiles();
 	if (gbProcessPlayers) {
 		gGameLogicStep = GameLogicStep::ProcessPlayers;
 		ProcessPlayers();
@@ -1727,6 +1801,15 @@ void OptionLanguageCodeChanged()
 
 const auto OptionChangeHandlerLanguage = (GetOptions().Language.code.SetValueChangedCallback(OptionLanguageCodeChanged), true);
 
+#ifndef UNPACKED_MPQS
+void OptionMpqBlockCacheChanged()
+{
+	SetMpqBlockCacheCapacity(static_cast<size_t>(*GetOptions().StartUp.mpqBlockCache) * 1024 * 1024);
+}
+
+const auto OptionChangeHandlerMpqBlockCache = (GetOptions().StartUp.mpqBlockCache.SetValueChangedCallback(OptionMpqBlockCacheChanged), true);
+#endif
+
 } // namespace
 
 void InitKeymapActions()
@@ -2655,6 +2738,10 @@ int DiabloMain(int argc, char **argv)
 	// Read settings including translation next. This will use the presence of fonts.mpq and look for assets in devilutionx.mpq
 	LoadOptions();
 	if (demo::IsRunning()) demo::OverrideOptions();
+#ifndef UNPACKED_MPQS
+	// Size the block cache before the game archives are read.
+	OptionMpqBlockCacheChanged();
+#endif
 
 	// Then look for a voice pack file based on the selected translation
 	LoadLanguageArchive();
@@ -2665,6 +2752,9 @@ int DiabloMain(int argc, char **argv)
 
 	// Finally load game data
 	LoadGameArchives();
+#ifndef UNPACKED_MPQS
+	PruneClxCache();
+#endif
 
 	LoadTextData();
 
@@ -3075,6 +3165,7 @@ void LoadGameLevelLightVision()
 {
 	if (leveltype != DTYPE_TOWN) {
 		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		UpdateLighting = true;
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 		ProcessLightList();
 		ProcessVisionList();
@@ -3141,6 +3232,7 @@ tl::expected<void, std::string> LoadGameLevelSetLevel(bool firstflag, lvl_entry
 	LoadSetMap();
 	IncProgress();
 	RETURN_IF_ERROR(GetLevelMTypes());
+	PrefetchMonsterGFX();
 	IncProgress();
 	InitGolems();
 	RETURN_IF_ERROR(InitMonsters());
@@ -3198,6 +3290,7 @@ tl::expected<void, std::string> LoadGameLevelStandardLevel(bool firstflag, lvl_e
 
 	if (leveltype != DTYPE_TOWN) {
 		RETURN_IF_ERROR(GetLevelMTypes());
+		PrefetchMonsterGFX();
 		InitThemes();
 		if (!HeadlessMode)
 			RETURN_IF_ERROR(LoadAllGFX());
@@ -3279,6 +3372,8 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	LoadGameLevelStopMusic(neededTrack);
 	LoadGameLevelResetCursor();
 	SetRndSeedForDungeonLevel();
+	PrefetchLvlGFX();
+	InvalidateDistanceFields();
 
 	IncProgress();
 
@@ -3288,8 +3383,10 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 
 	IncProgress();
 
+	const bool restoredMicros = RestoreDungeonMicros(pDungeonCels, MicroTileLen);
 	RETURN_IF_ERROR(LoadLvlGFX());
-	SetDungeonMicros(pDungeonCels, MicroTileLen);
+	if (!restoredMicros)
+		SetDungeonMicros(pDungeonCels, MicroTileLen);
 	ClearClxDrawCache();
 
 	IncProgress();
@@ -3351,9 +3448,11 @@ tl::expected<void, std::string> LoadGameLevel(bool firstflag, lvl_entry lvldir)
 	ActivateVirtualGamepad();
 #endif
 	LoadGameLevelStartMusic(neededTrack);
+	FinishAssetPrefetch();
 
 	CompleteProgress();
 
+	InvalidateLevelLayout();
 	LoadGameLevelCalculateCursor();
 	return {};
 }
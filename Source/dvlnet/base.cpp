@@ -98,7 +98,7 @@ tl::expected<void, PacketError> base::HandleTurn(packet &pkt)
 {
 	const plr_t src = pkt.Source();
 	PlayerState &playerState = playerStateTable_[src];
-	std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	return pkt.Turn().transform([&](turn_t &&turn) {
 		turnQueue.push_back(turn);
 		MakeReady(turn.SequenceNumber);
@@ -190,7 +190,9 @@ tl::expected<void, PacketError> base::RecvLocal(packet &pkt)
 	switch (pkt.Type()) {
 	case PT_MESSAGE:
 		return pkt.Message().transform([&](const buffer_t *message) {
-			message_queue.emplace_back(pkt.Source(), *message);
+			buffer_t payload = AcquirePacketBuffer();
+			payload.assign(message->begin(), message->end());
+			message_queue.emplace_back(pkt.Source(), std::move(payload));
 		});
 	case PT_TURN:
 		return HandleTurn(pkt);
@@ -215,7 +217,8 @@ bool base::SNetReceiveMessage(uint8_t *sender, void **data, size_t *size)
 	poll();
 	if (message_queue.empty())
 		return false;
-	message_last = message_queue.front();
+	ReleasePacketBuffer(std::move(message_last.payload));
+	message_last = std::move(message_queue.front());
 	message_queue.pop_front();
 	*sender = message_last.sender;
 	*size = message_last.payload.size();
@@ -228,7 +231,8 @@ bool base::SNetSendMessage(uint8_t playerId, void *data, size_t size)
 	if (playerId != SNPLAYER_OTHERS && playerId >= MAX_PLRS)
 		abort();
 	auto *rawMessage = reinterpret_cast<unsigned char *>(data);
-	const buffer_t message(rawMessage, rawMessage + size);
+	buffer_t message = AcquirePacketBuffer();
+	message.assign(rawMessage, rawMessage + size);
 	if (playerId == plr_self)
 		message_queue.emplace_back(plr_self, message);
 	plr_t dest;
@@ -238,7 +242,7 @@ bool base::SNetSendMessage(uint8_t playerId, void *data, size_t size)
 		dest = playerId;
 	if (dest != plr_self) {
 		tl::expected<std::unique_ptr<packet>, PacketError> pkt
-		    = pktfty->make_packet<PT_MESSAGE>(plr_self, dest, message);
+		    = pktfty->make_packet<PT_MESSAGE>(plr_self, dest, std::move(message));
 		if (!pkt.has_value()) {
 			LogError("make_packet: {}", pkt.error().what());
 			return false;
@@ -259,7 +263,7 @@ bool base::AllTurnsArrived()
 		if (!playerState.isConnected)
 			continue;
 
-		const std::deque<turn_t> &turnQueue = playerState.turnQueue;
+		const PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 		if (turnQueue.empty()) {
 			LogDebug("Turn missing from player {}", i);
 			return false;
@@ -282,7 +286,7 @@ bool base::SNetReceiveTurns(char **data, size_t *size, uint32_t *status)
 
 		status[i] |= PS_CONNECTED;
 
-		std::deque<turn_t> &turnQueue = playerState.turnQueue;
+		PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 		while (!turnQueue.empty()) {
 			const turn_t &turn = turnQueue.front();
 			const seq_t diff = turn.SequenceNumber - current_turn;
@@ -298,7 +302,7 @@ bool base::SNetReceiveTurns(char **data, size_t *size, uint32_t *status)
 			if (!playerState.isConnected)
 				continue;
 
-			std::deque<turn_t> &turnQueue = playerState.turnQueue;
+			PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 			if (turnQueue.empty())
 				continue;
 
@@ -325,7 +329,7 @@ bool base::SNetReceiveTurns(char **data, size_t *size, uint32_t *status)
 		if (!playerState.isConnected)
 			continue;
 
-		const std::deque<turn_t> &turnQueue = playerState.turnQueue;
+		const PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 		if (turnQueue.empty())
 			continue;
 
@@ -346,7 +350,7 @@ bool base::SNetSendTurn(char *data, size_t size)
 	next_turn++;
 
 	PlayerState &playerState = playerStateTable_[plr_self];
-	std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	turnQueue.push_back(turn);
 	SendTurnIfReady(turn);
 	return true;
@@ -374,7 +378,7 @@ tl::expected<void, PacketError> base::SendFirstTurnIfReady(plr_t player)
 		return {};
 
 	const PlayerState &playerState = playerStateTable_[plr_self];
-	const std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	const PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	if (turnQueue.empty())
 		return {};
 
@@ -402,7 +406,7 @@ tl::expected<void, PacketError> base::MakeReady(seq_t sequenceNumber)
 	awaitingSequenceNumber_ = false;
 
 	PlayerState &playerState = playerStateTable_[plr_self];
-	std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	for (turn_t &turn : turnQueue) {
 		turn.SequenceNumber = next_turn;
 		next_turn++;
@@ -511,7 +515,7 @@ bool base::SNetGetOwnerTurnsWaiting(uint32_t *turns)
 
 	const plr_t owner = GetOwner();
 	const PlayerState &playerState = playerStateTable_[owner];
-	const std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	const PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	*turns = static_cast<uint32_t>(turnQueue.size());
 
 	return true;
@@ -520,7 +524,7 @@ bool base::SNetGetOwnerTurnsWaiting(uint32_t *turns)
 bool base::SNetGetTurnsInTransit(uint32_t *turns)
 {
 	const PlayerState &playerState = playerStateTable_[plr_self];
-	const std::deque<turn_t> &turnQueue = playerState.turnQueue;
+	const PacketQueue<turn_t> &turnQueue = playerState.turnQueue;
 	*turns = static_cast<uint32_t>(turnQueue.size());
 	return true;
 }
@@ -2,9 +2,9 @@
 
 #include <array>
 #include <cstdint>
-#include <deque>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include <ankerl/unordered_dense.h>
 
@@ -55,14 +55,14 @@ protected:
 		}
 		message_t(int s, buffer_t p)
 		    : sender(s)
-		    , payload(p)
+		    , payload(std::move(p))
 		{
 		}
 	};
 
 	struct PlayerState {
 		bool isConnected = {};
-		std::deque<turn_t> turnQueue;
+		PacketQueue<turn_t> turnQueue;
 		int32_t lastTurnValue = {};
 		uint32_t roundTripLatency = {};
 	};
@@ -70,7 +70,7 @@ protected:
 	seq_t current_turn = 0;
 	seq_t next_turn = 0;
 	message_t message_last;
-	std::deque<message_t> message_queue;
+	PacketQueue<message_t> message_queue;
 
 	plr_t plr_self = PLR_BROADCAST;
 	cookie_t cookie_self = 0;
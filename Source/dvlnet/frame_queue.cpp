@@ -1,5 +1,6 @@
 #include "dvlnet/frame_queue.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "appfat.h"
@@ -25,35 +26,33 @@ framesize_t frame_queue::Size() const
 	return current_size;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::Read(framesize_t s)
+std::span<const unsigned char> frame_queue::Read(framesize_t s)
 {
-	if (current_size < s)
-		return tl::make_unexpected(FrameQueueError());
-	buffer_t ret;
-	while (s > 0 && s >= buffer_deque.front().size()) {
-		const framesize_t bufferSize = static_cast<framesize_t>(buffer_deque.front().size());
-		s -= bufferSize;
-		current_size -= bufferSize;
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().end());
-		buffer_deque.pop_front();
-	}
-	if (s > 0) {
-		ret.insert(ret.end(),
-		    buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		buffer_deque.front().erase(buffer_deque.front().begin(),
-		    buffer_deque.front().begin() + s);
-		current_size -= s;
-	}
+	const std::span<const unsigned char> ret { buffer.data() + read_pos, s };
+	read_pos += s;
+	current_size -= s;
+	if (current_size == 0)
+		read_pos = 0;
 	return ret;
 }
 
-void frame_queue::Write(buffer_t buf)
+void frame_queue::Write(std::span<const unsigned char> buf)
 {
+	if (read_pos + current_size + buf.size() > buffer.size()) {
+		const size_t requiredSize = current_size + buf.size();
+		if (read_pos != 0) {
+			// The unread bytes may overlap their new position at the front.
+			std::memmove(buffer.data(), buffer.data() + read_pos, current_size);
+			read_pos = 0;
+		}
+		// Unless there is plenty of room once the unread bytes are moved to the front, grow.
+		if (requiredSize > buffer.size() / 2) {
+			ReservePacketBuffer(buffer, 2 * requiredSize);
+			buffer.resize(2 * requiredSize);
+		}
+	}
+	std::copy(buf.begin(), buf.end(), buffer.begin() + static_cast<ptrdiff_t>(read_pos + current_size));
 	current_size += static_cast<framesize_t>(buf.size());
-	buffer_deque.push_back(std::move(buf));
 }
 
 tl::expected<bool, PacketError> frame_queue::PacketReady()
@@ -61,36 +60,33 @@ tl::expected<bool, PacketError> frame_queue::PacketReady()
 	if (nextsize == 0) {
 		if (Size() < sizeof(framesize_t))
 			return false;
-		tl::expected<buffer_t, PacketError> szbuf = Read(sizeof(framesize_t));
-		if (!szbuf.has_value())
-			return tl::make_unexpected(szbuf.error());
-		nextsize = LoadLE32(szbuf->data());
+		nextsize = LoadLE32(Read(sizeof(framesize_t)).data());
 		if (nextsize == 0)
 			return tl::make_unexpected(FrameQueueError());
 	}
 	return Size() >= nextsize;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::ReadPacket()
+tl::expected<std::span<const unsigned char>, PacketError> frame_queue::ReadPacket()
 {
 	if (nextsize == 0 || Size() < nextsize)
 		return tl::make_unexpected(FrameQueueError());
-	tl::expected<buffer_t, PacketError> ret = Read(nextsize);
+	const std::span<const unsigned char> ret = Read(nextsize);
 	nextsize = 0;
 	return ret;
 }
 
-tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(buffer_t packetbuf)
+tl::expected<buffer_t, PacketError> frame_queue::MakeFrame(const buffer_t &packetbuf)
 {
-	buffer_t ret;
+	buffer_t ret = AcquirePacketBuffer();
 	const framesize_t size = static_cast<framesize_t>(packetbuf.size());
 	if (size > max_frame_size)
 		return tl::make_unexpected("Buffer exceeds maximum frame size");
 	static_assert(sizeof(size) == 4, "framesize_t is not 4 bytes");
-	unsigned char sizeBuf[4];
-	WriteLE32(sizeBuf, size);
-	ret.insert(ret.end(), sizeBuf, sizeBuf + 4);
-	ret.insert(ret.end(), packetbuf.begin(), packetbuf.end());
+	ReservePacketBuffer(ret, sizeof(size) + size);
+	ret.resize(sizeof(size) + size);
+	WriteLE32(ret.data(), size);
+	std::copy(packetbuf.begin(), packetbuf.end(), ret.begin() + sizeof(size));
 	return ret;
 }
 
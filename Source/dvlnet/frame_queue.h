@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <exception>
+#include <span>
 #include <vector>
 
 #include <expected.hpp>
@@ -15,24 +16,39 @@ namespace net {
 typedef std::vector<unsigned char> buffer_t;
 typedef uint32_t framesize_t;
 
+/**
+ * @brief Splits a stream of received bytes into frames, each prefixed with its size.
+ *
+ * The bytes are kept in a single growable buffer. Unread bytes are moved to the front of the buffer
+ * when a write would not fit after them, so that every frame is contiguous and can be read without copying.
+ */
 class frame_queue {
 public:
 	constexpr static framesize_t max_frame_size = 0xFFFF;
 
 private:
+	buffer_t buffer;
+	/** Index of the first unread byte in `buffer`. */
+	size_t read_pos = 0;
 	framesize_t current_size = 0;
-	std::deque<buffer_t> buffer_deque;
 	framesize_t nextsize = 0;
 
 	framesize_t Size() const;
-	tl::expected<buffer_t, PacketError> Read(framesize_t s);
+	std::span<const unsigned char> Read(framesize_t s);
 
 public:
 	tl::expected<bool, PacketError> PacketReady();
-	tl::expected<buffer_t, PacketError> ReadPacket();
-	void Write(buffer_t buf);
 
-	static tl::expected<buffer_t, PacketError> MakeFrame(buffer_t packetbuf);
+	/**
+	 * @brief Reads the frame announced by the last call to `PacketReady`.
+	 * @return The frame's data, valid until the next call to `Write`.
+	 */
+	tl::expected<std::span<const unsigned char>, PacketError> ReadPacket();
+
+	void Write(std::span<const unsigned char> buf);
+
+	/** @brief Prefixes the packet with its size. The frame is a pooled buffer, see `ReleasePacketBuffer`. */
+	static tl::expected<buffer_t, PacketError> MakeFrame(const buffer_t &packetbuf);
 };
 
 } // namespace net
@@ -1,7 +1,12 @@
 #include "dvlnet/packet.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
 
 #ifdef PACKET_ENCRYPTION
 #include <sodium.h>
@@ -13,10 +18,125 @@
 #include <expected.hpp>
 
 #include "utils/algorithm/container.hpp"
+#include "utils/sdl_mutex.h"
 #include "utils/str_cat.hpp"
 
 namespace devilution::net {
 
+namespace {
+
+/** Capacity of new packet buffers, enough for the turns and messages of a game without growing. */
+constexpr size_t PacketBufferCapacity = 1024;
+
+/** Larger buffers, such as those of whole frames, are not kept. */
+constexpr size_t MaxPooledBufferCapacity = 2 * PacketBufferCapacity;
+
+constexpr size_t MaxPooledBuffers = 64;
+constexpr size_t MaxPooledPackets = 64;
+
+/** Storage of deleted packets, returned to the system when the game exits. */
+struct PacketFreeList : std::vector<void *> {
+	~PacketFreeList()
+	{
+		for (void *ptr : *this)
+			::operator delete(ptr);
+	}
+};
+
+/** Packets are made and sent from both the game and the network threads. */
+SdlMutex PacketPoolMutex;
+std::vector<buffer_t> PooledBuffers;
+PacketFreeList PooledPackets;
+PacketPoolStats PoolStats;
+
+} // namespace
+
+buffer_t AcquirePacketBuffer()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+		if (!PooledBuffers.empty()) {
+			buffer_t buf = std::move(PooledBuffers.back());
+			PooledBuffers.pop_back();
+			return buf;
+		}
+		PoolStats.bufferAllocations++;
+	}
+	buffer_t buf;
+	buf.reserve(PacketBufferCapacity);
+	return buf;
+}
+
+void ReleasePacketBuffer(buffer_t &&buf)
+{
+	if (buf.capacity() == 0 || buf.capacity() > MaxPooledBufferCapacity)
+		return;
+	buf.clear();
+	const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+	if (PooledBuffers.size() >= MaxPooledBuffers)
+		return;
+	if (PooledBuffers.capacity() == 0)
+		PooledBuffers.reserve(MaxPooledBuffers);
+	PooledBuffers.push_back(std::move(buf));
+}
+
+void CountPacketBufferRegrowth()
+{
+	const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+	PoolStats.bufferRegrowths++;
+}
+
+void CountPacketQueueAllocation()
+{
+	const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+	PoolStats.queueAllocations++;
+}
+
+PacketPoolStats GetPacketPoolStats()
+{
+	const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+	return PoolStats;
+}
+
+static_assert(sizeof(packet_in) == sizeof(packet) && sizeof(packet_out) == sizeof(packet),
+    "The packet pool assumes that packets of all kinds have the same size");
+
+void *packet::operator new(size_t size)
+{
+	if (size == sizeof(packet)) {
+		const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+		if (!PooledPackets.empty()) {
+			void *ptr = PooledPackets.back();
+			PooledPackets.pop_back();
+			return ptr;
+		}
+		PoolStats.packetAllocations++;
+	}
+	return ::operator new(size);
+}
+
+void packet::operator delete(void *ptr, size_t size)
+{
+	if (size == sizeof(packet)) {
+		const std::lock_guard<SdlMutex> lock(PacketPoolMutex);
+		if (PooledPackets.size() < MaxPooledPackets) {
+			if (PooledPackets.capacity() == 0)
+				PooledPackets.reserve(MaxPooledPackets);
+			PooledPackets.push_back(ptr);
+			return;
+		}
+	}
+	::operator delete(ptr);
+}
+
+packet::~packet()
+{
+	ReleasePacketBuffer(std::move(encrypted_buffer));
+	ReleasePacketBuffer(std::move(decrypted_buffer));
+	ReleasePacketBuffer(std::move(m_message));
+	ReleasePacketBuffer(std::move(m_info));
+}
+
 #ifdef PACKET_ENCRYPTION
 
 cookie_t packet_out::GenerateCookie()
@@ -205,13 +325,14 @@ tl::expected<void, PacketError> packet_in::Create(buffer_t buf)
 	if (buf.size() < sizeof(packet_type) + 2 * sizeof(plr_t))
 		return tl::make_unexpected(PacketError());
 
-	decrypted_buffer = std::move(buf);
+	std::swap(decrypted_buffer, buf);
+	ReleasePacketBuffer(std::move(buf));
 	have_decrypted = true;
 
 	// TCP server implementation forwards the original data to clients
 	// so although we are not decrypting anything,
 	// we save a copy in encrypted_buffer anyway
-	encrypted_buffer = decrypted_buffer;
+	encrypted_buffer.assign(decrypted_buffer.begin(), decrypted_buffer.end());
 	have_encrypted = true;
 	return {};
 }
@@ -220,7 +341,8 @@ tl::expected<void, PacketError> packet_in::Create(buffer_t buf)
 tl::expected<void, PacketError> packet_in::Decrypt(buffer_t buf)
 {
 	assert(!have_encrypted && !have_decrypted);
-	encrypted_buffer = std::move(buf);
+	std::swap(encrypted_buffer, buf);
+	ReleasePacketBuffer(std::move(buf));
 	have_encrypted = true;
 
 	if (encrypted_buffer.size() < crypto_secretbox_NONCEBYTES
@@ -230,6 +352,7 @@ tl::expected<void, PacketError> packet_in::Decrypt(buffer_t buf)
 	auto pktlen = (encrypted_buffer.size()
 	    - crypto_secretbox_NONCEBYTES
 	    - crypto_secretbox_MACBYTES);
+	ReservePacketBuffer(decrypted_buffer, pktlen);
 	decrypted_buffer.resize(pktlen);
 	const int status = crypto_secretbox_open_easy(
 	    decrypted_buffer.data(),
@@ -253,17 +376,22 @@ void packet_out::Encrypt()
 	if (have_encrypted)
 		return;
 
-	auto lenCleartext = decrypted_buffer.size();
+	// Encrypt in place: the cleartext is only needed to build the encrypted data.
+	// The nonce and the MAC go in front of it and the ciphertext overwrites it,
+	// which crypto_secretbox_easy allows.
+	std::swap(encrypted_buffer, decrypted_buffer);
+	const size_t lenCleartext = encrypted_buffer.size();
+	ReservePacketBuffer(encrypted_buffer, crypto_secretbox_NONCEBYTES + crypto_secretbox_MACBYTES + lenCleartext);
 	encrypted_buffer.insert(encrypted_buffer.begin(),
-	    crypto_secretbox_NONCEBYTES, 0);
-	encrypted_buffer.insert(encrypted_buffer.end(),
-	    crypto_secretbox_MACBYTES + lenCleartext, 0);
-	randombytes_buf(encrypted_buffer.data(), crypto_secretbox_NONCEBYTES);
+	    crypto_secretbox_NONCEBYTES + crypto_secretbox_MACBYTES, 0);
+	unsigned char *nonce = encrypted_buffer.data();
+	unsigned char *ciphertext = nonce + crypto_secretbox_NONCEBYTES;
+	randombytes_buf(nonce, crypto_secretbox_NONCEBYTES);
 	const int status = crypto_secretbox_easy(
-	    encrypted_buffer.data() + crypto_secretbox_NONCEBYTES,
-	    decrypted_buffer.data(),
+	    ciphertext,
+	    ciphertext + crypto_secretbox_MACBYTES,
 	    lenCleartext,
-	    encrypted_buffer.data(),
+	    nonce,
 	    key.data());
 	if (status != 0)
 		ABORT();
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 #include <expected.hpp>
 
@@ -111,6 +116,79 @@ inline PacketError IoHandlerError(std::string message)
 PacketError PacketTypeError(std::uint8_t unknownPacketType);
 PacketError PacketTypeError(std::initializer_list<packet_type> expectedTypes, std::uint8_t actual);
 
+/**
+ * @brief Returns an empty buffer for packet data, reusing a released one if possible.
+ *
+ * Packets take their buffers from this pool and give them back when destroyed,
+ * so that steady traffic does not allocate.
+ */
+buffer_t AcquirePacketBuffer();
+
+/** @brief Gives a buffer back to the pool for reuse. */
+void ReleasePacketBuffer(buffer_t &&buf);
+
+/** @brief Counts a packet buffer that had to grow, see `ReservePacketBuffer`. */
+void CountPacketBufferRegrowth();
+
+/** @brief Makes room for `size` bytes in a packet buffer, counting the reallocation if it has to grow. */
+inline void ReservePacketBuffer(buffer_t &buf, size_t size)
+{
+	if (size <= buf.capacity())
+		return;
+	CountPacketBufferRegrowth();
+	buf.reserve(std::max(size, 2 * buf.capacity()));
+}
+
+/** @brief Counts a block allocated by a `PacketQueue`. */
+void CountPacketQueueAllocation();
+
+/** @brief Allocator of `PacketQueue`, counts its allocations. */
+template <typename T>
+struct PacketQueueAllocator {
+	using value_type = T;
+
+	PacketQueueAllocator() = default;
+
+	template <typename U>
+	PacketQueueAllocator(const PacketQueueAllocator<U> &)
+	{
+	}
+
+	T *allocate(size_t n)
+	{
+		CountPacketQueueAllocation();
+		return std::allocator<T> {}.allocate(n);
+	}
+
+	void deallocate(T *ptr, size_t n)
+	{
+		std::allocator<T> {}.deallocate(ptr, n);
+	}
+
+	bool operator==(const PacketQueueAllocator &) const
+	{
+		return true;
+	}
+};
+
+/** @brief Queue of received turns or messages. */
+template <typename T>
+using PacketQueue = std::deque<T, PacketQueueAllocator<T>>;
+
+/** @brief Counts the heap allocations made by packets, their buffers and the queues of received packets. */
+struct PacketPoolStats {
+	/** Packets allocated because no released packet was available. */
+	size_t packetAllocations;
+	/** Buffers allocated because no released buffer was available. */
+	size_t bufferAllocations;
+	/** Reallocations of buffers that outgrew their capacity. */
+	size_t bufferRegrowths;
+	/** Blocks allocated by the queues of received turns and messages. */
+	size_t queueAllocations;
+};
+
+PacketPoolStats GetPacketPoolStats();
+
 class packet {
 protected:
 	packet_type m_type;
@@ -132,7 +210,18 @@ protected:
 
 public:
 	packet(const key_t &k)
-	    : key(k) {};
+	    : key(k)
+	    , encrypted_buffer(AcquirePacketBuffer())
+	    , decrypted_buffer(AcquirePacketBuffer()) {};
+
+	virtual ~packet();
+
+	packet(const packet &) = delete;
+	packet &operator=(const packet &) = delete;
+
+	/** Packets are allocated from a pool of released packets. */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
 
 	const buffer_t &Data();
 
@@ -227,6 +316,9 @@ tl::expected<void, PacketError> packet_proc<P>::process_data()
 
 inline tl::expected<void, PacketError> packet_in::process_element(buffer_t &x)
 {
+	if (x.capacity() == 0)
+		x = AcquirePacketBuffer();
+	ReservePacketBuffer(x, x.size() + decrypted_buffer.size());
 	x.insert(x.begin(), decrypted_buffer.begin(), decrypted_buffer.end());
 	decrypted_buffer.resize(0);
 	return {};
@@ -310,7 +402,7 @@ inline void packet_out::create<PT_JOIN_REQUEST>(plr_t s, plr_t d,
 	m_src = s;
 	m_dest = d;
 	m_cookie = c;
-	m_info = i;
+	m_info = std::move(i);
 }
 
 template <>
@@ -325,7 +417,7 @@ inline void packet_out::create<PT_JOIN_ACCEPT>(plr_t s, plr_t d, cookie_t c,
 	m_dest = d;
 	m_cookie = c;
 	m_newplr = n;
-	m_info = i;
+	m_info = std::move(i);
 }
 
 template <>
@@ -338,7 +430,7 @@ inline void packet_out::create<PT_CONNECT>(plr_t s, plr_t d, plr_t n, buffer_t i
 	m_src = s;
 	m_dest = d;
 	m_newplr = n;
-	m_info = i;
+	m_info = std::move(i);
 }
 
 template <>
@@ -393,6 +485,7 @@ inline void packet_out::create<PT_ECHO_REPLY>(plr_t s, plr_t d, timestamp_t t)
 
 inline tl::expected<void, PacketError> packet_out::process_element(buffer_t &x)
 {
+	ReservePacketBuffer(decrypted_buffer, decrypted_buffer.size() + x.size());
 	decrypted_buffer.insert(decrypted_buffer.end(), x.begin(), x.end());
 	return {};
 }
@@ -402,6 +495,7 @@ tl::expected<void, PacketError> packet_out::process_element(const T &x)
 {
 	static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Unsupported T");
 	static_assert(sizeof(T) == 4 || sizeof(T) == 2 || sizeof(T) == 1, "Unsupported T");
+	ReservePacketBuffer(decrypted_buffer, decrypted_buffer.size() + sizeof(T));
 	if (sizeof(T) == 4) {
 		unsigned char buf[4];
 		WriteLE32(buf, x);
@@ -426,8 +520,10 @@ public:
 	packet_factory();
 	packet_factory(std::string pw);
 	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(buffer_t buf);
+	/** @brief Makes a packet from received data, copied into a pooled buffer. */
+	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(std::span<const unsigned char> data);
 	template <packet_type t, typename... Args>
-	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(Args... args);
+	tl::expected<std::unique_ptr<packet>, PacketError> make_packet(Args &&...args);
 };
 
 inline tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_packet(buffer_t buf)
@@ -447,11 +543,18 @@ inline tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_p
 	return ret;
 }
 
+inline tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_packet(std::span<const unsigned char> data)
+{
+	buffer_t buf = AcquirePacketBuffer();
+	buf.assign(data.begin(), data.end());
+	return make_packet(std::move(buf));
+}
+
 template <packet_type t, typename... Args>
-tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_packet(Args... args)
+tl::expected<std::unique_ptr<packet>, PacketError> packet_factory::make_packet(Args &&...args)
 {
 	auto ret = std::make_unique<packet_out>(key);
-	ret->create<t>(args...);
+	ret->create<t>(std::forward<Args>(args)...);
 	if (const tl::expected<void, PacketError> result = ret->process_data(); !result.has_value()) {
 		return tl::make_unexpected(result.error());
 	}
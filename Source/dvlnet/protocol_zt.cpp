@@ -166,7 +166,7 @@ bool protocol_zt::recv_peer(const endpoint &peer)
 	while (true) {
 		auto len = lwip_recv(state.fd, buf, sizeof(buf), 0);
 		if (len >= 0) {
-			state.recv_queue.Write(buffer_t(buf, buf + len));
+			state.recv_queue.Write({ buf, static_cast<size_t>(len) });
 		} else {
 			return errno == EAGAIN || errno == EWOULDBLOCK;
 		}
@@ -262,13 +262,13 @@ bool protocol_zt::recv(endpoint &peer, buffer_t &data)
 		}
 		if (!*ready)
 			continue;
-		tl::expected<buffer_t, PacketError> packet = p.second.recv_queue.ReadPacket();
+		tl::expected<std::span<const unsigned char>, PacketError> packet = p.second.recv_queue.ReadPacket();
 		if (!packet.has_value()) {
 			LogError("Failed reading packet data from peer: {}", packet.error().what());
 			continue;
 		}
 		peer = p.first;
-		data = *packet;
+		data.assign(packet->begin(), packet->end());
 		return true;
 	}
 	return false;
@@ -151,9 +151,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 		RaiseIoHandlerError(packetError);
 		return;
 	}
-	recv_buffer.resize(bytesRead);
-	recv_queue.Write(std::move(recv_buffer));
-	recv_buffer.resize(frame_queue::max_frame_size);
+	recv_queue.Write({ recv_buffer.data(), bytesRead });
 	while (true) {
 		tl::expected<bool, PacketError> ready = recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -164,7 +162,7 @@ void tcp_client::HandleReceive(const asio::error_code &error, size_t bytesRead)
 			break;
 		tl::expected<void, PacketError> result
 		    = recv_queue.ReadPacket()
-		          .and_then([this](buffer_t &&pktData) { return pktfty->make_packet(pktData); })
+		          .and_then([this](std::span<const unsigned char> pktData) { return pktfty->make_packet(pktData); })
 		          .and_then([this](std::unique_ptr<packet> &&pkt) { return RecvLocal(*pkt); });
 		if (!result.has_value()) {
 			RaiseIoHandlerError(result.error());
@@ -192,10 +190,11 @@ tl::expected<void, PacketError> tcp_client::send(packet &pkt)
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
-	const asio::mutable_buffer buf = asio::buffer(*framePtr);
-	asio::async_write(sock, buf, [this, frame = std::move(framePtr)](const asio::error_code &error, size_t bytesSent) {
+	// Moving the frame into the handler keeps its data in place.
+	const asio::mutable_buffer buf = asio::buffer(*frame);
+	asio::async_write(sock, buf, [this, frameData = *std::move(frame)](const asio::error_code &error, size_t bytesSent) mutable {
 		HandleSend(error, bytesSent);
+		ReleasePacketBuffer(std::move(frameData));
 	});
 	return {};
 }
@@ -74,9 +74,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		DropConnection(con);
 		return;
 	}
-	con->recv_buffer.resize(bytesRead);
-	con->recv_queue.Write(std::move(con->recv_buffer));
-	con->recv_buffer.resize(frame_queue::max_frame_size);
+	con->recv_queue.Write({ con->recv_buffer.data(), bytesRead });
 	while (true) {
 		tl::expected<bool, PacketError> ready = con->recv_queue.PacketReady();
 		if (!ready.has_value()) {
@@ -86,7 +84,7 @@ void tcp_server::HandleReceive(const scc &con, const asio::error_code &ec,
 		}
 		if (!*ready)
 			break;
-		tl::expected<buffer_t, PacketError> pktData = con->recv_queue.ReadPacket();
+		tl::expected<std::span<const unsigned char>, PacketError> pktData = con->recv_queue.ReadPacket();
 		if (!pktData.has_value()) {
 			Log("ReadPacket: {}", pktData.error().what());
 			DropConnection(con);
@@ -184,11 +182,12 @@ tl::expected<void, PacketError> tcp_server::StartSend(const scc &con, packet &pk
 	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
 	if (!frame.has_value())
 		return tl::make_unexpected(frame.error());
-	std::unique_ptr<buffer_t> framePtr = std::make_unique<buffer_t>(*frame);
-	const asio::mutable_buffer buf = asio::buffer(*framePtr);
+	// Moving the frame into the handler keeps its data in place.
+	const asio::mutable_buffer buf = asio::buffer(*frame);
 	asio::async_write(con->socket, buf,
-	    [this, con, frame = std::move(framePtr)](const asio::error_code &ec, size_t bytesSent) {
+	    [this, con, frameData = *std::move(frame)](const asio::error_code &ec, size_t bytesSent) mutable {
 		    HandleSend(con, ec, bytesSent);
+		    ReleasePacketBuffer(std::move(frameData));
 	    });
 	return {};
 }
@@ -0,0 +1,125 @@
+#include "engine/asset_prefetch.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <ankerl/unordered_dense.h>
+
+#include "engine/assets.hpp"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+#include "utils/sdl_thread.h"
+#include "utils/string_view_hash.hpp"
+
+namespace devilution {
+
+namespace {
+
+struct PrefetchedAsset {
+	std::unique_ptr<std::byte[]> data;
+	size_t size;
+};
+
+/** Guards all of the state below. */
+SdlMutex StateMutex;
+/** Held by the prefetch thread while it reads `CurrentPath`. */
+SdlMutex ReadMutex;
+
+std::deque<std::string> Queue;
+std::string CurrentPath;
+ankerl::unordered_dense::map<std::string, PrefetchedAsset, StringViewHash, StringViewEquals> Prefetched;
+size_t NumTaken;
+bool IsWorkerRunning;
+SdlThread Worker;
+
+PrefetchedAsset ReadAsset(const std::string &path)
+{
+	size_t size;
+	// Each read uses its own archive handle so that it does not interfere with the loading thread.
+	AssetHandle handle = OpenAsset(path, size, /*threadsafe=*/true);
+	if (!handle.ok())
+		return { nullptr, 0 };
+	std::unique_ptr<std::byte[]> data { new std::byte[size] };
+	if (size > 0 && !handle.read(data.get(), size))
+		return { nullptr, 0 };
+	return { std::move(data), size };
+}
+
+void PrefetchWorker()
+{
+	std::unique_lock<SdlMutex> lock(StateMutex);
+	while (!Queue.empty()) {
+		CurrentPath = std::move(Queue.front());
+		Queue.pop_front();
+		ReadMutex.lock();
+		lock.unlock();
+
+		PrefetchedAsset asset = ReadAsset(CurrentPath);
+
+		lock.lock();
+		if (asset.data != nullptr)
+			Prefetched.emplace(std::move(CurrentPath), std::move(asset));
+		CurrentPath.clear();
+		ReadMutex.unlock();
+	}
+	IsWorkerRunning = false;
+}
+
+} // namespace
+
+void PrefetchAssets(std::span<const std::string> paths)
+{
+	const std::lock_guard<SdlMutex> lock(StateMutex);
+	Queue.insert(Queue.end(), paths.begin(), paths.end());
+	if (IsWorkerRunning || Queue.empty())
+		return;
+	// The previous worker has already released the mutex for good, so joining it here cannot deadlock.
+	Worker.join();
+	IsWorkerRunning = true;
+	Worker = SdlThread { PrefetchWorker };
+}
+
+std::unique_ptr<std::byte[]> TakePrefetchedAsset(std::string_view path, size_t &size)
+{
+	while (true) {
+		{
+			const std::lock_guard<SdlMutex> lock(StateMutex);
+			const auto it = Prefetched.find(path);
+			if (it != Prefetched.end()) {
+				std::unique_ptr<std::byte[]> data = std::move(it->second.data);
+				size = it->second.size;
+				Prefetched.erase(it);
+				++NumTaken;
+				return data;
+			}
+			if (CurrentPath != path) {
+				// Not worth waiting for, the caller will read it right away.
+				std::erase(Queue, path);
+				return nullptr;
+			}
+		}
+		// Wait for the prefetch thread to finish reading the file and try again.
+		const std::lock_guard<SdlMutex> readLock(ReadMutex);
+	}
+}
+
+void FinishAssetPrefetch()
+{
+	{
+		const std::lock_guard<SdlMutex> lock(StateMutex);
+		Queue.clear();
+	}
+	Worker.join();
+
+	const std::lock_guard<SdlMutex> lock(StateMutex);
+	if (NumTaken > 0 || !Prefetched.empty())
+		LogVerbose("Prefetched assets: {} used, {} unused", NumTaken, Prefetched.size());
+	Prefetched.clear();
+	NumTaken = 0;
+}
+
+} // namespace devilution
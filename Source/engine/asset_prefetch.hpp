@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace devilution {
+
+/**
+ * @brief Starts reading the given assets into memory on a background thread.
+ *
+ * This lets level loading overlap reading and decompressing the graphics of the level
+ * with the rest of the work it does. The loaders pick up the results via `TakePrefetchedAsset`.
+ */
+void PrefetchAssets(std::span<const std::string> paths);
+
+/**
+ * @brief Returns the contents of a prefetched asset, waiting for the read to finish if it is in progress.
+ *
+ * @return `nullptr` if the asset was not prefetched or could not be read,
+ * in which case the caller should load it by itself.
+ */
+std::unique_ptr<std::byte[]> TakePrefetchedAsset(std::string_view path, size_t &size);
+
+/**
+ * @brief Stops the prefetch thread and discards any prefetched assets that were not taken.
+ */
+void FinishAssetPrefetch();
+
+} // namespace devilution
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <mutex>
 #include <vector>
 
 #include "appfat.h"
@@ -19,7 +20,11 @@
 #endif
 
 #ifndef UNPACKED_MPQS
+#include <ankerl/unordered_dense.h>
+
+#include "mpq/mpq_block_cache.hpp"
 #include "mpq/mpq_sdl_rwops.hpp"
+#include "utils/sdl_mutex.h"
 #endif
 
 namespace devilution {
@@ -57,24 +62,77 @@ SDL_RWops *OpenOptionalRWops(const std::string &path)
 	return SDL_RWFromFile(path.c_str(), "rb");
 };
 
-bool FindMpqFile(std::string_view filename, MpqArchive **archive, uint32_t *fileNumber)
-{
-	const MpqFileHash fileHash = CalculateMpqFileHash(filename);
+struct MpqFileHashHash {
+	using is_avalanching = void;
+
+	[[nodiscard]] uint64_t operator()(const MpqFileHash &fileHash) const noexcept
+	{
+		// `fileHash[0]` only selects the hash table bucket, the other two identify the file.
+		return ankerl::unordered_dense::hash<uint64_t> {}((static_cast<uint64_t>(fileHash[1]) << 32) | fileHash[2]);
+	}
+};
+
+struct MpqFileLocation {
+	// `nullptr` if the file is not in any of the loaded archives.
+	MpqArchive *archive;
+	uint32_t fileNumber;
+};
 
+/**
+ * @brief Priority-resolved index of file hash to the archive that provides it.
+ *
+ * Entries (including misses) are added on first lookup, so a repeated lookup
+ * costs a single hash map probe regardless of how many archives are loaded.
+ * The index must be cleared whenever `MpqArchives` changes.
+ */
+ankerl::unordered_dense::map<MpqFileHash, MpqFileLocation, MpqFileHashHash> MpqFileIndex;
+
+// `FindAsset` is also called from the level loading and audio threads.
+SdlMutex MpqFileIndexMutex;
+
+MpqFileLocation ResolveMpqFile(const MpqFileHash &fileHash)
+{
+	uint32_t fileNumber;
 	for (auto &[_, mpqArchive] : MpqArchives) {
-		if (mpqArchive.GetFileNumber(fileHash, *fileNumber)) {
-			*archive = &mpqArchive;
-			return true;
+		if (mpqArchive.GetFileNumber(fileHash, fileNumber)) {
+			return { &mpqArchive, fileNumber };
 		}
 	}
+	return { nullptr, 0 };
+}
 
-	return false;
+bool FindMpqFile(std::string_view filename, MpqArchive **archive, uint32_t *fileNumber)
+{
+	const MpqFileHash fileHash = CalculateMpqFileHash(filename);
+
+	const std::lock_guard<SdlMutex> lock(MpqFileIndexMutex);
+	auto [it, inserted] = MpqFileIndex.try_emplace(fileHash);
+	if (inserted)
+		it->second = ResolveMpqFile(fileHash);
+
+	if (it->second.archive == nullptr)
+		return false;
+	*archive = it->second.archive;
+	*fileNumber = it->second.fileNumber;
+	return true;
 }
 
 #endif
 
 } // namespace
 
+void InvalidateAssetIndex()
+{
+#ifndef UNPACKED_MPQS
+	{
+		const std::lock_guard<SdlMutex> lock(MpqFileIndexMutex);
+		MpqFileIndex.clear();
+	}
+	// Blocks are keyed by archive ID, so the blocks of unloaded archives would only take up space.
+	ClearMpqBlockCache();
+#endif
+}
+
 #ifdef UNPACKED_MPQS
 AssetRef FindAsset(std::string_view filename)
 {
@@ -176,8 +234,12 @@ AssetHandle OpenAsset(AssetRef &&ref, bool threadsafe)
 #if UNPACKED_MPQS
 	return AssetHandle { OpenFile(ref.path, "rb") };
 #else
-	if (ref.archive != nullptr)
+	if (ref.archive != nullptr) {
+		const std::span<const std::byte> view = ref.archive->GetStoredFileView(ref.fileNumber);
+		if (!view.empty())
+			return AssetHandle { SDL_RWops_FromMappedView(ref.archive->GetMappedFile(), view) };
 		return AssetHandle { SDL_RWops_FromMpqFile(*ref.archive, ref.fileNumber, ref.filename, threadsafe) };
+	}
 	if (ref.directHandle != nullptr) {
 		// Transfer handle ownership:
 		SDL_RWops *handle = ref.directHandle;
@@ -224,6 +286,18 @@ tl::expected<AssetData, std::string> LoadAsset(std::string_view path)
 		return tl::make_unexpected(StrCat("Asset not found: ", path));
 	}
 
+#ifndef UNPACKED_MPQS
+	if (ref.archive != nullptr) {
+		const std::span<const std::byte> view = ref.archive->GetStoredFileView(ref.fileNumber);
+		if (!view.empty()) {
+			AssetData result { nullptr, view.size() };
+			result.view = reinterpret_cast<const char *>(view.data());
+			result.mapping = ref.archive->GetMappedFile();
+			return result;
+		}
+	}
+#endif
+
 	const size_t size = ref.size();
 	std::unique_ptr<char[]> data { new char[size] };
 
@@ -304,6 +378,8 @@ bool LoadMPQ(std::span<const std::string> paths, std::string_view mpqName, int p
 			auto [it, inserted] = MpqArchives.emplace(priority, *std::move(archive));
 			if (!inserted) {
 				LogError("MPQ with priority {} is already registered, skipping {}", priority, mpqName);
+			} else {
+				InvalidateAssetIndex();
 			}
 			return true;
 		}
@@ -391,7 +467,8 @@ void LoadCoreArchives()
 
 void LoadLanguageArchive()
 {
-	MpqArchives.erase(LangMpqPriority);
+	if (MpqArchives.erase(LangMpqPriority) != 0)
+		InvalidateAssetIndex();
 	const std::string_view code = GetLanguageCode();
 	if (code != "en") {
 		LoadMPQ(GetMPQSearchPaths(), code, LangMpqPriority);
@@ -472,6 +549,7 @@ void UnloadModArchives()
 			++it;
 		}
 	}
+	InvalidateAssetIndex();
 #endif
 }
 
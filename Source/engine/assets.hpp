@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <functional>
 #include <map>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
@@ -271,9 +272,14 @@ struct AssetData {
 	std::unique_ptr<char[]> data;
 	size_t size;
 
+	// Set instead of `data` when the asset is read directly from a memory-mapped archive.
+	// `mapping` keeps the mapping alive.
+	const char *view = nullptr;
+	std::shared_ptr<const void> mapping;
+
 	explicit operator std::string_view() const
 	{
-		return std::string_view(data.get(), size);
+		return std::string_view(view != nullptr ? view : data.get(), size);
 	}
 };
 
@@ -299,6 +305,13 @@ void LoadHellfireArchives();
 void UnloadModArchives();
 void LoadModArchives(std::span<const std::string_view> modnames);
 
+/**
+ * @brief Drops the cached file name to archive mapping used by `FindAsset`, and the cached blocks of the archives.
+ *
+ * Must be called after modifying `MpqArchives` directly.
+ */
+void InvalidateAssetIndex();
+
 #ifdef BUILD_TESTING
 [[nodiscard]] inline bool HaveMainData() { return MpqArchives.find(MainMpqPriority) != MpqArchives.end(); }
 #endif
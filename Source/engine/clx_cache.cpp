@@ -0,0 +1,301 @@
+#include "engine/clx_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "engine/assets.hpp"
+#include "options.h"
+#include "utils/endian_read.hpp"
+#include "utils/endian_write.hpp"
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+
+namespace {
+
+/**
+ * @brief Version of the cache entries.
+ *
+ * Must be incremented whenever the layout of the entries or the output of the converters changes.
+ */
+constexpr uint32_t ClxCacheVersion = 1;
+
+constexpr std::array<uint8_t, 4> ClxCacheMagic = { 'D', 'X', 'C', 'C' };
+
+/**
+ * Entry header, all values little-endian:
+ *
+ *  0: magic
+ *  4: version
+ *  8: key size
+ * 12: number of lists in the sheet, 0 for a list
+ * 14: padding
+ * 16: extra data size
+ * 20: CLX data size
+ * 24: hash of the key, extra data and CLX data
+ */
+constexpr size_t ClxCacheHeaderSize = 32;
+
+constexpr uint64_t Fnv1aOffsetBasis = 0xcbf29ce484222325;
+
+uint64_t Fnv1a(const uint8_t *data, size_t size, uint64_t hash = Fnv1aOffsetBasis)
+{
+	constexpr uint64_t Fnv1aPrime = 0x100000001b3;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= Fnv1aPrime;
+	}
+	return hash;
+}
+
+uint64_t HashEntry(const std::string &key, std::span<const uint8_t> extra, const uint8_t *data, size_t dataSize)
+{
+	uint64_t hash = Fnv1a(reinterpret_cast<const uint8_t *>(key.data()), key.size());
+	hash = Fnv1a(extra.data(), extra.size(), hash);
+	return Fnv1a(data, dataSize, hash);
+}
+
+std::string GetCacheDirectory()
+{
+	return StrCat(paths::PrefPath(), "clx_cache" DIRECTORY_SEPARATOR_STR);
+}
+
+std::string GetCacheEntryPath(const std::string &key)
+{
+	return StrCat(GetCacheDirectory(), fmt::format("{:016x}", Fnv1a(reinterpret_cast<const uint8_t *>(key.data()), key.size())), ".clx");
+}
+
+struct FileCloser {
+	void operator()(FILE *file) const
+	{
+		std::fclose(file);
+	}
+};
+
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+bool ReadExactly(FILE *file, void *out, size_t size)
+{
+	return size == 0 || std::fread(out, size, 1, file) == 1;
+}
+
+bool WriteExactly(FILE *file, const void *data, size_t size)
+{
+	return size == 0 || std::fwrite(data, size, 1, file) == 1;
+}
+
+struct EntryHeader {
+	uint32_t keySize;
+	uint16_t numLists;
+	uint32_t extraSize;
+	uint32_t dataSize;
+	uint64_t hash;
+};
+
+/**
+ * @brief Reads the header of a cache entry.
+ *
+ * Fails if the entry is from another version or its sizes do not add up to the size of the file,
+ * so that the sizes can be used to allocate memory.
+ */
+std::optional<EntryHeader> ReadEntryHeader(FILE *file, const std::string &entryPath)
+{
+	std::array<uint8_t, ClxCacheHeaderSize> header;
+	std::uintmax_t fileSize;
+	if (!GetFileSize(entryPath.c_str(), &fileSize)
+	    || !ReadExactly(file, header.data(), header.size())
+	    || !std::equal(ClxCacheMagic.begin(), ClxCacheMagic.end(), header.begin())
+	    || LoadLE32(&header[4]) != ClxCacheVersion) {
+		return std::nullopt;
+	}
+	const EntryHeader result {
+		LoadLE32(&header[8]),
+		LoadLE16(&header[12]),
+		LoadLE32(&header[16]),
+		LoadLE32(&header[20]),
+		LoadLE32(&header[24]) | (static_cast<uint64_t>(LoadLE32(&header[28])) << 32),
+	};
+	if (static_cast<std::uintmax_t>(ClxCacheHeaderSize) + result.keySize + result.extraSize + result.dataSize != fileSize)
+		return std::nullopt;
+	return result;
+}
+
+/**
+ * @brief Reads the extra and CLX data that follow the key of an entry.
+ *
+ * Fails if they do not match the hash of the entry.
+ */
+bool ReadEntryData(FILE *file, const EntryHeader &header, const std::string &key, std::vector<uint8_t> &extra, std::unique_ptr<uint8_t[]> &data)
+{
+	extra.resize(header.extraSize);
+	data.reset(new uint8_t[header.dataSize]);
+	return ReadExactly(file, extra.data(), extra.size())
+	    && ReadExactly(file, data.get(), header.dataSize)
+	    && HashEntry(key, extra, data.get(), header.dataSize) == header.hash;
+}
+
+/**
+ * @brief Checks whether the archive that a cache key refers to still has the same size and modification time.
+ */
+bool IsSourceUnchanged(const std::string &key)
+{
+	// Archive paths may contain the separator, so try each one.
+	for (size_t separator = key.find('|'); separator != std::string::npos; separator = key.find('|', separator + 1)) {
+		const std::optional<std::string> sourceKey = GetClxCacheSourceKey(key.substr(0, separator));
+		if (sourceKey && key.size() > sourceKey->size() && key.compare(0, sourceKey->size(), *sourceKey) == 0 && key[sourceKey->size()] == '|')
+			return true;
+	}
+	return false;
+}
+
+bool IsEntryCurrent(const std::string &entryPath)
+{
+	const FilePtr file { OpenFile(entryPath.c_str(), "rb") };
+	if (file == nullptr)
+		return false;
+	const std::optional<EntryHeader> header = ReadEntryHeader(file.get(), entryPath);
+	if (!header || header->dataSize == 0)
+		return false;
+	std::string key(header->keySize, '\0');
+	if (!ReadExactly(file.get(), key.data(), key.size()) || !IsSourceUnchanged(key))
+		return false;
+	std::vector<uint8_t> extra;
+	std::unique_ptr<uint8_t[]> data;
+	return ReadEntryData(file.get(), *header, key, extra, data);
+}
+
+} // namespace
+
+std::optional<std::string> GetClxCacheKey(std::string_view path, std::string_view params)
+{
+	if (!*GetOptions().StartUp.spriteCache)
+		return std::nullopt;
+#ifdef UNPACKED_MPQS
+	return std::nullopt;
+#else
+	const AssetRef ref = FindAsset(path);
+	if (ref.archive == nullptr)
+		return std::nullopt;
+	const std::optional<std::string> sourceKey = GetClxCacheSourceKey(ref.archive->GetPath());
+	if (!sourceKey)
+		return std::nullopt;
+	return fmt::format("{}|{}|{}|{}|{}", *sourceKey, ref.fileNumber, ref.size(), path, params);
+#endif
+}
+
+std::optional<std::string> GetClxCacheSourceKey(const std::string &sourcePath)
+{
+	std::uintmax_t size;
+	std::int64_t modificationTime;
+	if (!GetFileSize(sourcePath.c_str(), &size) || !GetFileModificationTime(sourcePath.c_str(), &modificationTime))
+		return std::nullopt;
+	return fmt::format("{}|{}|{}", sourcePath, size, modificationTime);
+}
+
+OptionalOwnedClxSpriteListOrSheet LoadCachedClx(const std::string &key, std::vector<uint8_t> *extra)
+{
+	const std::string entryPath = GetCacheEntryPath(key);
+	const FilePtr file { OpenFile(entryPath.c_str(), "rb") };
+	if (file == nullptr)
+		return std::nullopt;
+
+	const std::optional<EntryHeader> header = ReadEntryHeader(file.get(), entryPath);
+	if (!header || header->keySize != key.size()) {
+		LogVerbose("Ignoring invalid CLX cache entry {}", entryPath);
+		return std::nullopt;
+	}
+	const uint32_t dataSize = header->dataSize;
+
+	std::string storedKey(key.size(), '\0');
+	if (!ReadExactly(file.get(), storedKey.data(), storedKey.size()) || storedKey != key)
+		return std::nullopt;
+
+	if (dataSize == 0)
+		return std::nullopt;
+	std::vector<uint8_t> extraData;
+	std::unique_ptr<uint8_t[]> data;
+	if (!ReadEntryData(file.get(), *header, key, extraData, data)) {
+		LogVerbose("Ignoring invalid CLX cache entry {}", entryPath);
+		return std::nullopt;
+	}
+
+	if (extra != nullptr)
+		*extra = std::move(extraData);
+	return OwnedClxSpriteListOrSheet { std::move(data), header->numLists };
+}
+
+void StoreCachedClx(const std::string &key, ClxSpriteListOrSheet clx, std::span<const uint8_t> extra)
+{
+	const std::string directory = GetCacheDirectory();
+	if (!CreateDir(directory.c_str()))
+		return;
+
+	const uint8_t *data = clx.data();
+	const size_t dataSize = clx.dataSize();
+	const uint64_t hash = HashEntry(key, extra, data, dataSize);
+
+	std::array<uint8_t, ClxCacheHeaderSize> header {};
+	std::copy(ClxCacheMagic.begin(), ClxCacheMagic.end(), header.begin());
+	WriteLE32(&header[4], ClxCacheVersion);
+	WriteLE32(&header[8], static_cast<uint32_t>(key.size()));
+	WriteLE16(&header[12], clx.isSheet() ? clx.sheet().numLists() : 0);
+	WriteLE32(&header[16], static_cast<uint32_t>(extra.size()));
+	WriteLE32(&header[20], static_cast<uint32_t>(dataSize));
+	WriteLE32(&header[24], static_cast<uint32_t>(hash));
+	WriteLE32(&header[28], static_cast<uint32_t>(hash >> 32));
+
+	// Write to a temporary file first, so that an interrupted write never leaves a partial entry behind.
+	const std::string entryPath = GetCacheEntryPath(key);
+	const std::string tempPath = StrCat(entryPath, ".tmp");
+	bool written;
+	{
+		const FilePtr file { OpenFile(tempPath.c_str(), "wb") };
+		if (file == nullptr)
+			return;
+		written = WriteExactly(file.get(), header.data(), header.size())
+		    && WriteExactly(file.get(), key.data(), key.size())
+		    && WriteExactly(file.get(), extra.data(), extra.size())
+		    && WriteExactly(file.get(), data, dataSize);
+	}
+	if (!written) {
+		LogError("Failed to write CLX cache entry {}", tempPath);
+		RemoveFile(tempPath.c_str());
+		return;
+	}
+	// Replaces an entry that failed to load, as MoveFile on Windows does not overwrite an existing file.
+	if (FileExists(entryPath.c_str()))
+		RemoveFile(entryPath.c_str());
+	RenameFile(tempPath.c_str(), entryPath.c_str());
+}
+
+void PruneClxCache()
+{
+	if (!*GetOptions().StartUp.spriteCache)
+		return;
+	const std::string directory = GetCacheDirectory();
+	if (!DirectoryExists(directory.c_str()))
+		return;
+	size_t numRemoved = 0;
+	for (const std::string &name : ListFiles(directory.c_str())) {
+		const std::string entryPath = StrCat(directory, name);
+		// Leftover temporary files are from interrupted writes.
+		if (name.ends_with(".clx") && IsEntryCurrent(entryPath))
+			continue;
+		RemoveFile(entryPath.c_str());
+		++numRemoved;
+	}
+	if (numRemoved != 0)
+		LogVerbose("Removed {} stale CLX cache entries", numRemoved);
+}
+
+} // namespace devilution
@@ -0,0 +1,65 @@
+/**
+ * @file clx_cache.hpp
+ *
+ * On-disk cache of sprites converted to CLX from the legacy CEL, CL2 and PCX formats.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/clx_sprite.hpp"
+
+namespace devilution {
+
+/**
+ * @brief Returns the key under which the conversion of an asset is cached.
+ *
+ * The key identifies the archive that the asset is read from, including its size and modification time,
+ * the asset itself and the conversion parameters.
+ *
+ * @param path Path of the asset in the game data.
+ * @param params Conversion parameters. Must differ whenever the converted sprite would.
+ * @return nullopt if the cache is disabled or the asset is not read from an archive.
+ */
+std::optional<std::string> GetClxCacheKey(std::string_view path, std::string_view params);
+
+/**
+ * @brief Returns the start of the keys of all assets read from the given file.
+ *
+ * Changes whenever the file is modified.
+ *
+ * @return nullopt if the file does not exist.
+ */
+std::optional<std::string> GetClxCacheSourceKey(const std::string &sourcePath);
+
+/**
+ * @brief Loads a converted sprite list or sheet from the cache.
+ *
+ * @param key A key from `GetClxCacheKey`.
+ * @param extra If not null, receives the extra data stored along with the sprite.
+ * @return nullopt if the sprite is not cached or the cache entry is invalid.
+ */
+OptionalOwnedClxSpriteListOrSheet LoadCachedClx(const std::string &key, std::vector<uint8_t> *extra = nullptr);
+
+/**
+ * @brief Stores a converted sprite list or sheet in the cache.
+ *
+ * @param key A key from `GetClxCacheKey`.
+ * @param clx The converted sprite list or sheet.
+ * @param extra Extra data to store along with the sprite, such as its palette.
+ */
+void StoreCachedClx(const std::string &key, ClxSpriteListOrSheet clx, std::span<const uint8_t> extra = {});
+
+/**
+ * @brief Removes cache entries that are invalid or whose archive has changed or no longer exists.
+ *
+ * Does nothing while the sprite cache option is disabled.
+ */
+void PruneClxCache();
+
+} // namespace devilution
@@ -486,6 +486,11 @@ public:
 		return num_lists_ != 0;
 	}
 
+	[[nodiscard]] constexpr const uint8_t *data() const
+	{
+		return data_;
+	}
+
 	[[nodiscard]] size_t dataSize() const
 	{
 		return isSheet() ? sheet().dataSize() : list().dataSize();
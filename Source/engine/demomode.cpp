@@ -1,9 +1,15 @@
 #include "engine/demomode.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -148,6 +154,114 @@ uint32_t StartTime = 0;
 uint16_t DemoGraphicsWidth = 640;
 uint16_t DemoGraphicsHeight = 480;
 
+/** Time spent on a game tick during playback, split between game logic and rendering. */
+struct FrameTiming {
+	uint32_t logicMicroseconds;
+	uint32_t renderMicroseconds;
+
+	[[nodiscard]] uint32_t totalMicroseconds() const
+	{
+		return logicMicroseconds + renderMicroseconds;
+	}
+};
+
+struct TimingSummary {
+	uint32_t mean;
+	uint32_t p50;
+	uint32_t p90;
+	uint32_t p99;
+	uint32_t max;
+};
+
+/** Number of the slowest frames listed in the timing log. */
+constexpr size_t NumWorstFrames = 10;
+
+std::string TimingLogPath;
+std::vector<FrameTiming> FrameTimings;
+std::chrono::steady_clock::time_point GameTickStartTime;
+std::chrono::steady_clock::time_point GameTickLogicEndTime;
+
+uint32_t MicrosecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+/** @brief Nearest-rank percentile of sorted values. */
+uint32_t Percentile(const std::vector<uint32_t> &sorted, unsigned percent)
+{
+	const size_t rank = (sorted.size() * percent + 99) / 100;
+	return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+template <typename Projection>
+TimingSummary Summarize(Projection projection)
+{
+	if (FrameTimings.empty())
+		return {};
+	std::vector<uint32_t> values;
+	values.reserve(FrameTimings.size());
+	std::transform(FrameTimings.begin(), FrameTimings.end(), std::back_inserter(values), projection);
+	std::sort(values.begin(), values.end());
+	const uint64_t sum = std::accumulate(values.begin(), values.end(), uint64_t { 0 });
+	return {
+		static_cast<uint32_t>(sum / values.size()),
+		Percentile(values, 50),
+		Percentile(values, 90),
+		Percentile(values, 99),
+		values.back(),
+	};
+}
+
+void AppendSummary(std::string &json, std::string_view name, const TimingSummary &summary)
+{
+	fmt::format_to(std::back_inserter(json),
+	    "  \"{}\": {{ \"mean\": {}, \"p50\": {}, \"p90\": {}, \"p99\": {}, \"max\": {} }},\n",
+	    name, summary.mean, summary.p50, summary.p90, summary.p99, summary.max);
+}
+
+/**
+ * @brief Writes the frame timings of the playback as JSON.
+ *
+ * All times are in microseconds. `frames` lists the logic and render time of every game tick in order.
+ */
+void WriteTimingLog(float seconds)
+{
+	std::string json;
+	fmt::format_to(std::back_inserter(json), "{{\n  \"demo\": {},\n  \"frames\": {},\n  \"seconds\": {:.3f},\n",
+	    DemoNumber, FrameTimings.size(), seconds);
+	AppendSummary(json, "logic", Summarize([](const FrameTiming &timing) { return timing.logicMicroseconds; }));
+	AppendSummary(json, "render", Summarize([](const FrameTiming &timing) { return timing.renderMicroseconds; }));
+	AppendSummary(json, "total", Summarize([](const FrameTiming &timing) { return timing.totalMicroseconds(); }));
+
+	std::vector<size_t> worstFrames(FrameTimings.size());
+	std::iota(worstFrames.begin(), worstFrames.end(), 0);
+	const size_t numWorstFrames = std::min(NumWorstFrames, worstFrames.size());
+	std::partial_sort(worstFrames.begin(), worstFrames.begin() + numWorstFrames, worstFrames.end(), [](size_t a, size_t b) {
+		return FrameTimings[a].totalMicroseconds() > FrameTimings[b].totalMicroseconds();
+	});
+	json += "  \"worstFrames\": [";
+	for (size_t i = 0; i < numWorstFrames; i++) {
+		const FrameTiming &timing = FrameTimings[worstFrames[i]];
+		fmt::format_to(std::back_inserter(json), "{}\n    {{ \"frame\": {}, \"logic\": {}, \"render\": {} }}",
+		    i == 0 ? "" : ",", worstFrames[i], timing.logicMicroseconds, timing.renderMicroseconds);
+	}
+	json += "\n  ],\n  \"frameTimes\": [";
+	for (size_t i = 0; i < FrameTimings.size(); i++) {
+		fmt::format_to(std::back_inserter(json), "{}\n    [{}, {}]",
+		    i == 0 ? "" : ",", FrameTimings[i].logicMicroseconds, FrameTimings[i].renderMicroseconds);
+	}
+	json += "\n  ]\n}\n";
+
+	FILE *out = OpenFile(TimingLogPath.c_str(), "wb");
+	if (out == nullptr) {
+		LogError("Failed to open {} for writing", TimingLogPath);
+		return;
+	}
+	if (std::fwrite(json.data(), json.size(), 1, out) != 1)
+		LogError("Failed to write {}", TimingLogPath);
+	std::fclose(out);
+}
+
 void ReadSettings(FILE *in, uint8_t version) // NOLINT(readability-identifier-length)
 {
 	DemoGraphicsWidth = ReadLE16(in);
@@ -584,6 +698,11 @@ void InitPlayBack(int demoNumber, bool timedemo)
 	diablo_quit(1);
 }
 
+void InitTimingLog(std::string_view path)
+{
+	TimingLogPath = path;
+}
+
 void InitRecording(int recordNumber, bool createDemoReference)
 {
 	RecordNumber = recordNumber;
@@ -809,9 +928,30 @@ void RecordMessage(const SDL_Event &event, uint16_t modState)
 	}
 }
 
+void NotifyGameTickStart()
+{
+	if (IsRunning())
+		GameTickStartTime = std::chrono::steady_clock::now();
+}
+
+void NotifyGameTickLogicEnd()
+{
+	if (IsRunning())
+		GameTickLogicEndTime = std::chrono::steady_clock::now();
+}
+
+void NotifyGameTickEnd()
+{
+	if (!IsRunning())
+		return;
+	const auto now = std::chrono::steady_clock::now();
+	FrameTimings.push_back({ MicrosecondsBetween(GameTickStartTime, GameTickLogicEndTime), MicrosecondsBetween(GameTickLogicEndTime, now) });
+}
+
 void NotifyGameLoopStart()
 {
 	LogicTick = 0;
+	FrameTimings.clear();
 
 	if (IsRunning()) {
 		StartTime = SDL_GetTicks();
@@ -843,9 +983,17 @@ void NotifyGameLoopEnd()
 		CreateDemoReference = false;
 	}
 
+	const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
+	if (IsRunning() && !TimingLogPath.empty())
+		WriteTimingLog(seconds);
+
 	if (IsRunning() && !HeadlessMode) {
-		const float seconds = (SDL_GetTicks() - StartTime) / 1000.0F;
 		SDL_Log("%d frames, %.2f seconds: %.1f fps", LogicTick, seconds, LogicTick / seconds);
+		const TimingSummary logic = Summarize([](const FrameTiming &timing) { return timing.logicMicroseconds; });
+		const TimingSummary render = Summarize([](const FrameTiming &timing) { return timing.renderMicroseconds; });
+		SDL_Log("Frame times (ms): logic p50 %.2f p99 %.2f max %.2f, render p50 %.2f p99 %.2f max %.2f",
+		    logic.p50 / 1000.0, logic.p99 / 1000.0, logic.max / 1000.0,
+		    render.p50 / 1000.0, render.p99 / 1000.0, render.max / 1000.0);
 		gbRunGameResult = false;
 		gbRunGame = false;
 
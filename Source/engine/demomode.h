@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
 #include <SDL.h>
 
@@ -16,6 +17,8 @@ namespace demo {
 #ifndef DISABLE_DEMOMODE
 void InitPlayBack(int demoNumber, bool timedemo);
 void InitRecording(int recordNumber, bool createDemoReference);
+/** @brief Writes the time spent on each game tick of the playback as JSON to `path` once it ends. */
+void InitTimingLog(std::string_view path);
 void OverrideOptions();
 
 bool IsRunning();
@@ -29,6 +32,11 @@ void RecordMessage(const SDL_Event &event, uint16_t modState);
 void NotifyGameLoopStart();
 void NotifyGameLoopEnd();
 
+void NotifyGameTickStart();
+/** @brief Marks the end of the game logic of a tick, the rest until `NotifyGameTickEnd` is rendering. */
+void NotifyGameTickLogicEnd();
+void NotifyGameTickEnd();
+
 uint32_t SimulateMillisecondsSinceStartup();
 #else
 inline void OverrideOptions()
@@ -62,6 +70,15 @@ inline void NotifyGameLoopStart()
 inline void NotifyGameLoopEnd()
 {
 }
+inline void NotifyGameTickStart()
+{
+}
+inline void NotifyGameTickLogicEnd()
+{
+}
+inline void NotifyGameTickEnd()
+{
+}
 inline uint32_t SimulateMillisecondsSinceStartup()
 {
 	return 0;
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include <expected.hpp>
@@ -13,6 +15,7 @@
 #ifdef UNPACKED_MPQS
 #include "engine/load_clx.hpp"
 #else
+#include "engine/clx_cache.hpp"
 #include "engine/load_file.hpp"
 #include "utils/cl2_to_clx.hpp"
 #endif
@@ -26,9 +29,22 @@ tl::expected<OwnedClxSpriteListOrSheet, std::string> LoadCl2ListOrSheetWithStatu
 #ifdef UNPACKED_MPQS
 	return LoadClxListOrSheetWithStatus(path);
 #else
+	// Per-frame widths are only known by address, so only sprites with a single width are cached.
+	std::optional<std::string> cacheKey;
+	if (!widthOrWidths.HoldsPointer()) {
+		cacheKey = GetClxCacheKey(path, StrCat("cl2 width=", widthOrWidths.AsValue()));
+		if (cacheKey) {
+			OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(*cacheKey);
+			if (cached)
+				return std::move(*cached);
+		}
+	}
 	size_t size;
 	ASSIGN_OR_RETURN(std::unique_ptr<uint8_t[]> data, LoadFileInMemWithStatus<uint8_t>(path, &size));
-	return Cl2ToClx(std::move(data), size, widthOrWidths);
+	OwnedClxSpriteListOrSheet result = Cl2ToClx(std::move(data), size, widthOrWidths);
+	if (cacheKey)
+		StoreCachedClx(*cacheKey, result);
+	return result;
 #endif
 }
 
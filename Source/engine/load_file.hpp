@@ -5,10 +5,12 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <type_traits>
 
 #include <expected.hpp>
 
 #include "appfat.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/assets.hpp"
 #include "headless_mode.hpp"
 #include "mpq/mpq_common.hpp"
@@ -86,6 +88,18 @@ template <typename T = std::byte>
 tl::expected<std::unique_ptr<T[]>, std::string> LoadFileInMemWithStatus(const char *path, std::size_t *numRead = nullptr)
 {
 	size_t size;
+	if (std::unique_ptr<std::byte[]> prefetched = TakePrefetchedAsset(path, size); prefetched != nullptr && (size % sizeof(T)) == 0) {
+		if (numRead != nullptr)
+			*numRead = size / sizeof(T);
+		if constexpr (std::is_same_v<T, std::byte>) {
+			return { std::move(prefetched) };
+		} else {
+			std::unique_ptr<T[]> buf { new T[size / sizeof(T)] };
+			memcpy(buf.get(), prefetched.get(), size);
+			return { std::move(buf) };
+		}
+	}
+
 	AssetHandle handle = OpenAsset(path, size);
 	if (!handle.ok()) {
 		if (HeadlessMode) return {};
@@ -147,6 +161,7 @@ struct MultiFileLoader {
 		StaticVector<std::array<char, MaxMpqPathSize>, MaxFiles> paths;
 		StaticVector<AssetRef, MaxFiles> files;
 		StaticVector<uint32_t, MaxFiles> sizes;
+		StaticVector<std::unique_ptr<std::byte[]>, MaxFiles> prefetched;
 		size_t totalSize = 0;
 		for (size_t i = 0, j = 0; i < numFiles; ++i) {
 			if (!filterFn(i))
@@ -157,11 +172,16 @@ struct MultiFileLoader {
 				memcpy(paths.back().data(), path, strlen(path) + 1);
 			}
 			const char *path = paths.back().data();
-			files.emplace_back(FindAsset(path));
-			if (!ValidatAssetRef(path, files.back()))
-				return nullptr;
-
-			const size_t size = files.back().size();
+			size_t size;
+			prefetched.emplace_back(TakePrefetchedAsset(path, size));
+			if (prefetched.back() != nullptr) {
+				files.emplace_back();
+			} else {
+				files.emplace_back(FindAsset(path));
+				if (!ValidatAssetRef(path, files.back()))
+					return nullptr;
+				size = files.back().size();
+			}
 			sizes.emplace_back(static_cast<uint32_t>(size));
 			outOffsets[j] = static_cast<uint32_t>(totalSize);
 			totalSize += size;
@@ -172,6 +192,11 @@ struct MultiFileLoader {
 		for (size_t i = 0, j = 0; i < numFiles; ++i) {
 			if (!filterFn(i))
 				continue;
+			if (prefetched[j] != nullptr) {
+				memcpy(&buf[outOffsets[j]], prefetched[j].get(), sizes[j]);
+				++j;
+				continue;
+			}
 			AssetHandle handle = OpenAsset(std::move(files[j]));
 			if (!handle.ok() || !handle.read(&buf[outOffsets[j]], sizes[j])) {
 				FailedToOpenFileError(paths[j].data(), handle.error());
@@ -4,7 +4,10 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #ifdef DEBUG_PCX_TO_CL2_SIZE
 #include <iostream>
@@ -21,6 +24,7 @@
 #include "engine/load_file.hpp"
 #else
 #include "engine/assets.hpp"
+#include "engine/clx_cache.hpp"
 #include "utils/pcx.hpp"
 #include "utils/pcx_to_clx.hpp"
 #endif
@@ -58,6 +62,24 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	}
 	return result;
 #else
+	const std::optional<std::string> cacheKey = GetClxCacheKey(path,
+	    StrCat("pcx frames=", numFramesOrFrameHeight, " transparent=", transparentColor ? *transparentColor + 1 : 0, " palette=", outPalette != nullptr ? 1 : 0));
+	if (cacheKey) {
+		std::vector<uint8_t> palette;
+		OptionalOwnedClxSpriteListOrSheet cached = LoadCachedClx(*cacheKey, &palette);
+		if (cached && !cached->isSheet() && palette.size() == (outPalette != nullptr ? 256 * 3 : 0)) {
+			for (size_t i = 0; i < palette.size() / 3; ++i) {
+				outPalette[i].r = palette[i * 3];
+				outPalette[i].g = palette[i * 3 + 1];
+				outPalette[i].b = palette[i * 3 + 2];
+#ifndef USE_SDL1
+				outPalette[i].a = SDL_ALPHA_OPAQUE;
+#endif
+			}
+			return std::move(*cached).list();
+		}
+	}
+
 	size_t fileSize;
 	AssetHandle handle = OpenAsset(path, fileSize);
 	if (!handle.ok()) {
@@ -71,6 +93,18 @@ OptionalOwnedClxSpriteList LoadPcxSpriteList(const char *filename, int numFrames
 	OptionalOwnedClxSpriteList result = PcxToClx(handle, fileSize, numFramesOrFrameHeight, transparentColor, outPalette);
 	if (!result)
 		return std::nullopt;
+	if (cacheKey) {
+		std::vector<uint8_t> palette;
+		if (outPalette != nullptr) {
+			palette.reserve(256 * 3);
+			for (unsigned i = 0; i < 256; ++i) {
+				palette.push_back(outPalette[i].r);
+				palette.push_back(outPalette[i].g);
+				palette.push_back(outPalette[i].b);
+			}
+		}
+		StoreCachedClx(*cacheKey, ClxSpriteListOrSheet { ClxSpriteList { *result }.data(), 0 }, palette);
+	}
 	return result;
 #endif
 }
@@ -35,6 +35,8 @@ extern const int PathDiagonalStepCost;
  * @param path Resulting path represented as the step directions, which are indices in `PathDirs`. Must have room for `maxPathLength` steps.
  * @param maxPathLength The maximum allowed length of the resulting path.
  * @return The length of the resulting path, or 0 if there is no valid path.
+ *
+ * The template overload in engine/path_impl.hpp finds the same path with the checks inlined.
  */
 int FindPath(tl::function_ref<bool(Point, Point)> canStep, tl::function_ref<bool(Point)> posOk, Point startPosition, Point destinationPosition, int8_t *path, size_t maxPathLength);
 
@@ -0,0 +1,138 @@
+#include "engine/profiler.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <string>
+
+#include <SDL.h>
+#include <fmt/format.h>
+
+#include "utils/file_util.h"
+#include "utils/log.hpp"
+#include "utils/sdl_mutex.h"
+
+namespace devilution::profiler {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** The trace is written out whenever this many bytes of events are buffered. */
+constexpr size_t TraceFlushSize = 64 * 1024;
+
+constexpr std::array<std::string_view, NumZones> ZoneNames {
+	"ProcessMonsters",
+	"ProcessMissiles",
+	"ProcessObjects",
+	"ProcessLightList",
+	"ProcessVisionList",
+	"DrawView",
+	"DrawMain",
+	"nthread_send_and_recv_turn",
+};
+
+/** Zones are also entered from the network thread. */
+SdlMutex ProfilerMutex;
+
+std::array<Clock::duration, NumZones> ZoneTotals {};
+std::array<uint32_t, NumZones> ZoneMicrosecondsPerFrame {};
+uint32_t FramesSinceLastUpdate;
+Clock::time_point LastUpdate = Clock::now();
+
+FILE *TraceFile;
+Clock::time_point TraceStart;
+std::string TraceBuffer;
+bool TraceHasEvents;
+
+int64_t MicrosecondsSinceTraceStart(Clock::time_point time)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time - TraceStart).count();
+}
+
+void FlushTrace()
+{
+	if (!TraceBuffer.empty())
+		std::fwrite(TraceBuffer.data(), 1, TraceBuffer.size(), TraceFile);
+	TraceBuffer.clear();
+}
+
+void AppendTraceEvent(Zone zone, Clock::time_point start, Clock::time_point end)
+{
+	const int64_t startUs = MicrosecondsSinceTraceStart(start);
+	fmt::format_to(std::back_inserter(TraceBuffer),
+	    R"({}{{"name":"{}","cat":"game","ph":"X","ts":{},"dur":{},"pid":1,"tid":{}}})",
+	    TraceHasEvents ? ",\n" : "\n", ZoneName(zone), startUs, MicrosecondsSinceTraceStart(end) - startUs, SDL_ThreadID());
+	TraceHasEvents = true;
+	if (TraceBuffer.size() >= TraceFlushSize)
+		FlushTrace();
+}
+
+} // namespace
+
+std::string_view ZoneName(Zone zone)
+{
+	return ZoneNames[static_cast<size_t>(zone)];
+}
+
+ScopedZone::~ScopedZone()
+{
+	const Clock::time_point end = Clock::now();
+	const std::lock_guard<SdlMutex> lock(ProfilerMutex);
+	ZoneTotals[static_cast<size_t>(zone_)] += end - start_;
+	if (TraceFile != nullptr)
+		AppendTraceEvent(zone_, start_, end);
+}
+
+void EndFrame()
+{
+	const std::lock_guard<SdlMutex> lock(ProfilerMutex);
+	FramesSinceLastUpdate++;
+	const Clock::time_point now = Clock::now();
+	if (now - LastUpdate < std::chrono::seconds(1))
+		return;
+	for (size_t i = 0; i < NumZones; i++) {
+		const auto total = std::chrono::duration_cast<std::chrono::microseconds>(ZoneTotals[i]).count();
+		ZoneMicrosecondsPerFrame[i] = static_cast<uint32_t>(total / FramesSinceLastUpdate);
+		ZoneTotals[i] = {};
+	}
+	FramesSinceLastUpdate = 0;
+	LastUpdate = now;
+}
+
+uint32_t GetZoneMicrosecondsPerFrame(Zone zone)
+{
+	const std::lock_guard<SdlMutex> lock(ProfilerMutex);
+	return ZoneMicrosecondsPerFrame[static_cast<size_t>(zone)];
+}
+
+bool StartTrace(const char *path)
+{
+	const std::lock_guard<SdlMutex> lock(ProfilerMutex);
+	if (TraceFile != nullptr)
+		return false;
+	TraceFile = OpenFile(path, "wb");
+	if (TraceFile == nullptr) {
+		LogError("Failed to open trace file {}", path);
+		return false;
+	}
+	TraceStart = Clock::now();
+	TraceHasEvents = false;
+	TraceBuffer = R"({"displayTimeUnit":"ms","traceEvents":[)";
+	return true;
+}
+
+void StopTrace()
+{
+	const std::lock_guard<SdlMutex> lock(ProfilerMutex);
+	if (TraceFile == nullptr)
+		return;
+	TraceBuffer.append("\n]}\n");
+	FlushTrace();
+	std::fclose(TraceFile);
+	TraceFile = nullptr;
+}
+
+} // namespace devilution::profiler
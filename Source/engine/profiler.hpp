@@ -0,0 +1,88 @@
+/**
+ * @file profiler.hpp
+ *
+ * Opt-in timing of the main subsystems of the game loop, built with the DEVILUTIONX_PROFILER option.
+ *
+ * Without that option, `DVL_PROFILE_ZONE` expands to nothing.
+ */
+#pragma once
+
+#ifdef DEVILUTIONX_PROFILER
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace devilution::profiler {
+
+enum class Zone : uint8_t {
+	ProcessMonsters,
+	ProcessMissiles,
+	ProcessObjects,
+	ProcessLightList,
+	ProcessVisionList,
+	DrawView,
+	DrawMain,
+	NetTurn,
+};
+
+constexpr size_t NumZones = static_cast<size_t>(Zone::NetTurn) + 1;
+
+std::string_view ZoneName(Zone zone);
+
+/** @brief Times the enclosing scope. Use through `DVL_PROFILE_ZONE`. */
+class ScopedZone {
+public:
+	explicit ScopedZone(Zone zone)
+	    : zone_(zone)
+	    , start_(std::chrono::steady_clock::now())
+	{
+	}
+
+	~ScopedZone();
+
+	ScopedZone(const ScopedZone &) = delete;
+	ScopedZone &operator=(const ScopedZone &) = delete;
+
+private:
+	Zone zone_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Marks the end of a drawn frame.
+ *
+ * Once a second, the time spent in each zone is averaged over the frames drawn since the previous update.
+ */
+void EndFrame();
+
+/** @brief Average time spent in the zone per frame, as of the last update. */
+uint32_t GetZoneMicrosecondsPerFrame(Zone zone);
+
+/**
+ * @brief Starts writing every zone to a trace file in the Chrome trace event format.
+ *
+ * The file can be opened with Perfetto or chrome://tracing.
+ *
+ * @return false if the file could not be opened.
+ */
+bool StartTrace(const char *path);
+
+/** @brief Finishes and closes the trace file, if any. */
+void StopTrace();
+
+} // namespace devilution::profiler
+
+#define DVL_PROFILE_ZONE_CONCAT_IMPL(a, b) a##b
+#define DVL_PROFILE_ZONE_CONCAT(a, b) DVL_PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+/** @brief Times the rest of the enclosing scope as the given `profiler::Zone`. */
+#define DVL_PROFILE_ZONE(zone) \
+	const ::devilution::profiler::ScopedZone DVL_PROFILE_ZONE_CONCAT(dvlProfileZone, __LINE__)(::devilution::profiler::Zone::zone)
+
+#else
+
+#define DVL_PROFILE_ZONE(zone) static_cast<void>(0)
+
+#endif
@@ -74,10 +74,17 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitFillWithLightmap(uint8_t *dst, unsi
 	});
 }
 
+/** @brief Rows at least this long are lit with Lightmap::adjustColors, shorter ones are not worth the function call. */
+constexpr unsigned MinLightmapVectorLength = 32;
+
 DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsWithLightmap(uint8_t *DVL_RESTRICT dst, const uint8_t *DVL_RESTRICT src, unsigned length, const Lightmap &lightmap)
 {
 	DVL_ASSUME(length != 0);
 	const uint8_t *light = lightmap.getLightingAt(dst);
+	if (length >= MinLightmapVectorLength) {
+		lightmap.adjustColors(src, light, length, dst);
+		return;
+	}
 	std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, dst, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
 		return lightmap.adjustColor(srcColor, lightLevel);
 	});
@@ -161,9 +168,13 @@ DVL_ALWAYS_INLINE DVL_ATTRIBUTE_HOT void BlitPixelsBlendedWithLightmap(uint8_t *
 
 	if (length < 1024) {
 		uint8_t litSrc[1024];
-		std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, litSrc, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
-			return lightmap.adjustColor(srcColor, lightLevel);
-		});
+		if (length >= MinLightmapVectorLength) {
+			lightmap.adjustColors(src, light, length, litSrc);
+		} else {
+			std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY src, src + length, light, litSrc, [&lightmap](uint8_t srcColor, uint8_t lightLevel) {
+				return lightmap.adjustColor(srcColor, lightLevel);
+			});
+		}
 		std::transform(DEVILUTIONX_BLIT_EXECUTION_POLICY litSrc, litSrc + length, dst, dst, [pal = paletteTransparencyLookup](uint8_t srcColor, uint8_t dstColor) {
 			return pal[dstColor][srcColor];
 		});
@@ -241,6 +241,7 @@ using OutlineRowSolidRuns = StaticVector<std::pair<uint8_t, uint8_t>, MaxOutline
 struct OutlinePixelsCacheEntry {
 	OutlinePixels outlinePixels;
 	const void *spriteData = nullptr;
+	const uint8_t *trn = nullptr;
 	bool skipColorIndexZero;
 };
 OutlinePixelsCacheEntry OutlinePixelsCache;
@@ -284,8 +285,11 @@ void AppendOutlineRowSolidRuns(uint8_t x, uint8_t w, OutlineRowSolidRuns &solidR
 	}
 }
 
+/**
+ * @param trn Translation applied to the colors before checking for color index 0, or nullptr
+ */
 template <bool SkipColorIndexZero>
-void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-function-cognitive-complexity)
+void GetOutline(ClxSprite sprite, const uint8_t *trn, OutlinePixels &result) // NOLINT(readability-function-cognitive-complexity)
 {
 	const unsigned width = sprite.width();
 	assert(width < MaxOutlineSpriteWidth);
@@ -313,7 +317,7 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 					if (IsClxOpaqueFill(v)) {
 						w = GetClxOpaqueFillWidth(v);
 						const auto color = static_cast<uint8_t>(*src++);
-						if (color != 0) {
+						if ((trn != nullptr ? trn[color] : color) != 0) {
 							AppendOutlineRowSolidRuns(x, w, *solidRunAbove);
 						}
 					} else {
@@ -321,7 +325,7 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 						bool prevZero = solidRunAbove->empty() || solidRunAbove->back().second != x;
 						for (unsigned i = 0; i < w; ++i) {
 							const auto color = static_cast<uint8_t>(src[i]);
-							if (color == 0) {
+							if ((trn != nullptr ? trn[color] : color) == 0) {
 								if (!prevZero) ++solidRunAbove->back().second;
 								prevZero = true;
 							} else {
@@ -389,22 +393,24 @@ void GetOutline(ClxSprite sprite, OutlinePixels &result) // NOLINT(readability-f
 }
 
 template <bool SkipColorIndexZero>
-void UpdateOutlinePixelsCache(ClxSprite sprite)
+void UpdateOutlinePixelsCache(ClxSprite sprite, const uint8_t *trn)
 {
 	if (OutlinePixelsCache.spriteData == sprite.pixelData()
+	    && OutlinePixelsCache.trn == trn
 	    && OutlinePixelsCache.skipColorIndexZero == SkipColorIndexZero) {
 		return;
 	}
 	OutlinePixelsCache.skipColorIndexZero = SkipColorIndexZero;
 	OutlinePixelsCache.spriteData = sprite.pixelData();
+	OutlinePixelsCache.trn = trn;
 	OutlinePixelsCache.outlinePixels.clear();
-	GetOutline<SkipColorIndexZero>(sprite, OutlinePixelsCache.outlinePixels);
+	GetOutline<SkipColorIndexZero>(sprite, trn, OutlinePixelsCache.outlinePixels);
 }
 
 template <bool SkipColorIndexZero>
-void RenderClxOutline(const Surface &out, Point position, ClxSprite sprite, uint8_t color)
+void RenderClxOutline(const Surface &out, Point position, ClxSprite sprite, uint8_t color, const uint8_t *trn = nullptr)
 {
-	UpdateOutlinePixelsCache<SkipColorIndexZero>(sprite);
+	UpdateOutlinePixelsCache<SkipColorIndexZero>(sprite, trn);
 	--position.x;
 	position.y -= sprite.height();
 	if (position.x >= 0 && position.x + sprite.width() + 2 < out.w()
@@ -618,6 +624,11 @@ void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position
 	RenderClxOutline</*SkipColorIndexZero=*/true>(out, position, clx, col);
 }
 
+void ClxDrawOutlineSkipColorZeroTRN(const Surface &out, uint8_t col, Point position, ClxSprite clx, const uint8_t *trn)
+{
+	RenderClxOutline</*SkipColorIndexZero=*/true>(out, position, clx, col, trn);
+}
+
 void ClearClxDrawCache()
 {
 	OutlinePixelsCache.spriteData = nullptr;
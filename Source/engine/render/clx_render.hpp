@@ -61,6 +61,17 @@ void ClxDrawOutline(const Surface &out, uint8_t col, Point position, ClxSprite c
  */
 void ClxDrawOutlineSkipColorZero(const Surface &out, uint8_t col, Point position, ClxSprite clx);
 
+/**
+ * @brief Same as `ClxDrawOutlineSkipColorZero` but checks the colors after applying the given TRN.
+ *
+ * @param col Color index from current palette
+ * @param out Output buffer
+ * @param position Target buffer coordinate
+ * @param clx CLX frame
+ * @param trn TRN to apply to the sprite colors, or nullptr
+ */
+void ClxDrawOutlineSkipColorZeroTRN(const Surface &out, uint8_t col, Point position, ClxSprite clx, const uint8_t *trn);
+
 /**
  * @brief Blit CL2 sprite, and apply given TRN to the given buffer at the given coordinates
  * @param out Output buffer
@@ -13,6 +13,12 @@
 #include "engine/point.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung_defs.hpp"
+#include "utils/attributes.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && DVL_HAVE_ATTRIBUTE(target)
+#define DEVILUTIONX_LIGHTMAP_AVX2
+#include <immintrin.h>
+#endif
 
 namespace devilution {
 
@@ -20,6 +26,51 @@ namespace {
 
 std::vector<uint8_t> LightmapBuffer;
 
+static_assert(sizeof(std::array<uint8_t, LightTableSize>) == LightTableSize, "Light tables must be contiguous");
+
+using AdjustColorsFn = void (*)(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, uint8_t *DVL_RESTRICT out, const uint8_t *lightTables);
+
+void AdjustColorsScalar(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, uint8_t *DVL_RESTRICT out, const uint8_t *lightTables)
+{
+	for (unsigned i = 0; i < length; i++)
+		out[i] = lightTables[light[i] * LightTableSize + src[i]];
+}
+
+#ifdef DEVILUTIONX_LIGHTMAP_AVX2
+__attribute__((target("avx2"))) void AdjustColorsAvx2(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, uint8_t *DVL_RESTRICT out, const uint8_t *lightTables)
+{
+	// Gathers load 4 bytes, so each lookup loads the aligned dword containing the entry and shifts the entry down.
+	// This never reads past the end of the light tables.
+	const auto *base = reinterpret_cast<const int *>(lightTables);
+	const __m256i dwordMask = _mm256_set1_epi32(~3);
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i three = _mm256_set1_epi32(3);
+	unsigned i = 0;
+	for (; i + 8 <= length; i += 8) {
+		const __m256i color = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + i)));
+		const __m256i lightLevel = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(light + i)));
+		const __m256i index = _mm256_or_si256(_mm256_slli_epi32(lightLevel, 8), color);
+		const __m256i dwords = _mm256_i32gather_epi32(base, _mm256_and_si256(index, dwordMask), 1);
+		const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(index, three), 3);
+		const __m256i result = _mm256_and_si256(_mm256_srlv_epi32(dwords, shift), byteMask);
+		const __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(words, words));
+	}
+	AdjustColorsScalar(src + i, light + i, length - i, out + i, lightTables);
+}
+#endif
+
+AdjustColorsFn SelectAdjustColors()
+{
+#ifdef DEVILUTIONX_LIGHTMAP_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		return AdjustColorsAvx2;
+#endif
+	return AdjustColorsScalar;
+}
+
+const AdjustColorsFn AdjustColorsImpl = SelectAdjustColors();
+
 void RenderFullTile(Point position, uint8_t lightLevel, uint8_t *lightmap, uint16_t pitch)
 {
 	uint8_t *top = lightmap + (position.y + 1) * pitch + position.x - TILE_WIDTH / 2;
@@ -503,6 +554,11 @@ Lightmap::Lightmap(const uint8_t *outBuffer, uint16_t outPitch,
 {
 }
 
+void Lightmap::adjustColors(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, uint8_t *DVL_RESTRICT out) const
+{
+	AdjustColorsImpl(src, light, length, out, lightTables[0].data());
+}
+
 Lightmap Lightmap::build(bool perPixelLighting, Point tilePosition, Point targetBufferPosition,
     int viewportWidth, int viewportHeight, int rows, int columns,
     const uint8_t *outBuffer, uint16_t outPitch,
@@ -8,6 +8,7 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/point.hpp"
 #include "levels/gendung_defs.hpp"
+#include "utils/attributes.h"
 
 namespace devilution {
 
@@ -30,6 +31,13 @@ public:
 		return lightTables[lightLevel][color];
 	}
 
+	/**
+	 * @brief Same as calling adjustColor for each pixel of a row.
+	 *
+	 * Uses vector gathers when the CPU supports them, which is faster than the scalar lookups for all but the shortest rows.
+	 */
+	void adjustColors(const uint8_t *DVL_RESTRICT src, const uint8_t *DVL_RESTRICT light, unsigned length, uint8_t *DVL_RESTRICT out) const;
+
 	const uint8_t *getLightingAt(const uint8_t *outLoc) const
 	{
 		const ptrdiff_t outDist = outLoc - outBuffer;
@@ -46,6 +54,14 @@ public:
 		return lightmapBuffer.data() + row * lightmapPitch + rowOffset;
 	}
 
+	/**
+	 * @brief Returns this lightmap for another buffer with the same size as the one it was built for.
+	 */
+	[[nodiscard]] Lightmap forBuffer(const uint8_t *buffer, uint16_t pitch) const
+	{
+		return Lightmap(buffer, pitch, lightmapBuffer, lightmapPitch, lightTables, fullyLitLightTable_, fullyDarkLightTable_);
+	}
+
 	[[nodiscard]] bool isFullyLitLightTable(const uint8_t *lightTable) const { return lightTable == fullyLitLightTable_; }
 	[[nodiscard]] bool isFullyDarkLightTable(const uint8_t *lightTable) const { return lightTable == fullyDarkLightTable_; }
 
@@ -0,0 +1,78 @@
+#include "engine/render/partial_redraw.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace devilution {
+
+bool IsDamagedAreaEmpty(const Rectangle &rect)
+{
+	return rect.size.width <= 0 || rect.size.height <= 0;
+}
+
+Rectangle MergeDamagedAreas(const Rectangle &a, const Rectangle &b)
+{
+	if (IsDamagedAreaEmpty(a)) return b;
+	if (IsDamagedAreaEmpty(b)) return a;
+	const int left = std::min(a.position.x, b.position.x);
+	const int top = std::min(a.position.y, b.position.y);
+	const int right = std::max(a.position.x + a.size.width, b.position.x + b.size.width);
+	const int bottom = std::max(a.position.y + a.size.height, b.position.y + b.size.height);
+	return { { left, top }, { right - left, bottom - top } };
+}
+
+Rectangle ClipDamagedArea(const Rectangle &a, const Rectangle &b)
+{
+	const int left = std::max(a.position.x, b.position.x);
+	const int top = std::max(a.position.y, b.position.y);
+	const int right = std::min(a.position.x + a.size.width, b.position.x + b.size.width);
+	const int bottom = std::min(a.position.y + a.size.height, b.position.y + b.size.height);
+	return { { left, top }, { std::max(0, right - left), std::max(0, bottom - top) } };
+}
+
+void AddDamagedArea(DamagedAreaList &areas, Rectangle area, Rectangle bounds)
+{
+	area = ClipDamagedArea(area, bounds);
+	if (IsDamagedAreaEmpty(area))
+		return;
+
+	// Merging can make the area overlap ones that were checked before, so start over after each merge
+	for (size_t i = 0; i < areas.size();) {
+		if (IsDamagedAreaEmpty(ClipDamagedArea(area, areas[i]))) {
+			i++;
+			continue;
+		}
+		area = MergeDamagedAreas(area, areas[i]);
+		areas.erase(&areas[i]);
+		i = 0;
+	}
+	if (areas.size() == MaxDamagedAreas) {
+		for (const Rectangle &damagedArea : areas)
+			area = MergeDamagedAreas(area, damagedArea);
+		areas.clear();
+	}
+	areas.push_back(area);
+}
+
+void ForEachChangedRowBand(const Surface &current, const Surface &presented, int height, tl::function_ref<void(int top, int bottom)> changedRows)
+{
+	// Rows this close together are blitted at once
+	constexpr int MaxRowGap = 8;
+
+	int y = 0;
+	while (y < height) {
+		if (memcmp(current.at(0, y), presented.at(0, y), current.w()) == 0) {
+			y++;
+			continue;
+		}
+		const int top = y;
+		int bottom = ++y;
+		for (; y < height && y - bottom < MaxRowGap; y++) {
+			if (memcmp(current.at(0, y), presented.at(0, y), current.w()) != 0)
+				bottom = y + 1;
+		}
+		changedRows(top, bottom);
+	}
+}
+
+} // namespace devilution
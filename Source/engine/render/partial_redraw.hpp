@@ -0,0 +1,52 @@
+/**
+ * @file partial_redraw.hpp
+ *
+ * Bookkeeping for redrawing and blitting only the parts of the screen that changed.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include <function_ref.hpp>
+
+#include "engine/rectangle.hpp"
+#include "engine/surface.hpp"
+#include "utils/static_vector.hpp"
+
+namespace devilution {
+
+/** @brief More damaged areas than this are merged into one. */
+constexpr size_t MaxDamagedAreas = 16;
+
+using DamagedAreaList = StaticVector<Rectangle, MaxDamagedAreas>;
+
+[[nodiscard]] bool IsDamagedAreaEmpty(const Rectangle &rect);
+
+/** @brief Returns the smallest rectangle containing both rectangles, ignoring empty ones. */
+[[nodiscard]] Rectangle MergeDamagedAreas(const Rectangle &a, const Rectangle &b);
+
+/** @brief Returns the overlap of both rectangles, which is empty if they do not overlap. */
+[[nodiscard]] Rectangle ClipDamagedArea(const Rectangle &a, const Rectangle &b);
+
+/**
+ * @brief Records an area that needs to be redrawn.
+ *
+ * Overlapping areas are merged so that no pixel gets redrawn twice.
+ * @param areas Areas recorded so far, none of which overlap
+ * @param area Area to add
+ * @param bounds The area is clipped to these bounds
+ */
+void AddDamagedArea(DamagedAreaList &areas, Rectangle area, Rectangle bounds);
+
+/**
+ * @brief Finds the bands of rows at the top of `current` that differ from `presented`.
+ *
+ * Bands separated by only a few unchanged rows are joined.
+ * @param current The surface that is about to be presented
+ * @param presented What was presented before, with the same size as `current`
+ * @param height Number of rows to check
+ * @param changedRows Called with the first row of each band and the row after it
+ */
+void ForEachChangedRowBand(const Surface &current, const Surface &presented, int height, tl::function_ref<void(int top, int bottom)> changedRows);
+
+} // namespace devilution
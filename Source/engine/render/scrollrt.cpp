@@ -5,9 +5,14 @@
  */
 #include "engine/render/scrollrt.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 
@@ -22,10 +27,13 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/displacement.hpp"
 #include "engine/dx.h"
+#include "engine/palette.h"
 #include "engine/point.hpp"
+#include "engine/profiler.hpp"
 #include "engine/render/clx_render.hpp"
 #include "engine/render/dun_render.hpp"
 #include "engine/render/light_render.hpp"
+#include "engine/render/partial_redraw.hpp"
 #include "engine/render/text_render.hpp"
 #include "engine/trn.hpp"
 #include "engine/world_tile.hpp"
@@ -104,6 +112,18 @@ constexpr auto RightFrameDisplacement = Displacement { DunFrameWidth, 0 };
  */
 ankerl::unordered_dense::map<WorldTilePosition, std::vector<Missile *>> MissilesAtRenderingTile;
 
+/**
+ * @brief Position of the buffer being rendered to, relative to the top left corner of the game view.
+ *
+ * Only non-zero while a damaged area of the view is redrawn on its own.
+ */
+Displacement RenderOrigin;
+
+/**
+ * @brief How far a sprite may reach past the bounds of the tile it is drawn from.
+ */
+constexpr int MaxSpriteOverhang = 4 * TILE_WIDTH;
+
 /**
  * @brief Could the missile (at the next game tick) collide? This method is a simplified version of CheckMissileCol (for example without random).
  */
@@ -251,6 +271,45 @@ inline void ClxDrawLightBlended(const Surface &out, Point position, ClxSprite cl
 	}
 }
 
+/**
+ * @brief Blit a monster sprite, applying the palette translation of its type before another translation
+ * @param out Output buffer
+ * @param position Target buffer coordinate
+ * @param clx CLX frame
+ * @param typeTrn Palette translation of the monster type, or nullptr
+ * @param trn Palette translation applied afterwards, or nullptr
+ */
+void ClxDrawMonsterTRN(const Surface &out, Point position, ClxSprite clx, const uint8_t *typeTrn, const uint8_t *trn)
+{
+	if (typeTrn == nullptr) {
+		if (trn != nullptr)
+			ClxDrawTRN(out, position, clx, trn);
+		else
+			ClxDraw(out, position, clx);
+		return;
+	}
+	if (trn == nullptr) {
+		ClxDrawTRN(out, position, clx, typeTrn);
+		return;
+	}
+	std::array<uint8_t, 256> combinedTrn;
+	for (size_t i = 0; i < combinedTrn.size(); ++i)
+		combinedTrn[i] = trn[typeTrn[i]];
+	ClxDrawTRN(out, position, clx, combinedTrn.data());
+}
+
+/**
+ * @brief Blit a monster sprite, applying the palette translation of its type and lighting
+ * @param out Output buffer
+ * @param position Target buffer coordinate
+ * @param clx CLX frame
+ * @param typeTrn Palette translation of the monster type, or nullptr
+ */
+void ClxDrawMonsterLight(const Surface &out, Point position, ClxSprite clx, const uint8_t *typeTrn, int lightTableIndex)
+{
+	ClxDrawMonsterTRN(out, position, clx, typeTrn, lightTableIndex != 0 ? LightTables[lightTableIndex].data() : nullptr);
+}
+
 /**
  * @brief Save the content behind the cursor to a temporary buffer, then draw the cursor.
  */
@@ -321,12 +380,14 @@ void DrawMissilePrivate(const Surface &out, const Missile &missile, Point target
 
 	const Point missileRenderPosition { targetBufferPosition + missile.position.offsetForRendering - Displacement { missile._miAnimWidth2, 0 } };
 	const ClxSprite sprite = (*missile._miAnimData)[missile._miAnimFrame - 1];
+	// Charging monsters are drawn with the sprites of their type
+	const uint8_t *typeTrn = missile._mitype == MissileID::Rhino ? Monsters[missile._misource].type().getTRN(*missile._miAnimData) : nullptr;
 	if (missile._miUniqTrans != 0) {
-		ClxDrawTRN(out, missileRenderPosition, sprite, Monsters[missile._misource].uniqueMonsterTRN.get());
+		ClxDrawMonsterTRN(out, missileRenderPosition, sprite, typeTrn, Monsters[missile._misource].uniqueMonsterTRN.get());
 	} else if (missile._miLightFlag) {
-		ClxDrawLight(out, missileRenderPosition, sprite, lightTableIndex);
+		ClxDrawMonsterLight(out, missileRenderPosition, sprite, typeTrn, lightTableIndex);
 	} else {
-		ClxDraw(out, missileRenderPosition, sprite);
+		ClxDrawMonsterTRN(out, missileRenderPosition, sprite, typeTrn, nullptr);
 	}
 }
 
@@ -361,9 +422,10 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 	}
 
 	const ClxSprite sprite = monster.animInfo.currentSprite();
+	const uint8_t *typeTrn = monster.type().getTRN(*monster.animInfo.sprites);
 
 	if (!IsTileLit(tilePosition)) {
-		ClxDrawTRN(out, targetBufferPosition, sprite, GetInfravisionTRN());
+		ClxDrawMonsterTRN(out, targetBufferPosition, sprite, typeTrn, GetInfravisionTRN());
 		return;
 	}
 	uint8_t *trn = nullptr;
@@ -374,9 +436,9 @@ void DrawMonster(const Surface &out, Point tilePosition, Point targetBufferPosit
 	if (MyPlayer->_pInfraFlag && lightTableIndex > 8)
 		trn = GetInfravisionTRN();
 	if (trn != nullptr)
-		ClxDrawTRN(out, targetBufferPosition, sprite, trn);
+		ClxDrawMonsterTRN(out, targetBufferPosition, sprite, typeTrn, trn);
 	else
-		ClxDrawLight(out, targetBufferPosition, sprite, lightTableIndex);
+		ClxDrawMonsterLight(out, targetBufferPosition, sprite, typeTrn, lightTableIndex);
 }
 
 /**
@@ -570,7 +632,7 @@ void DrawCell(const Surface &out, const Lightmap lightmap, Point tilePosition, P
 
 	// Create a special lightmap buffer to bleed light up walls
 	uint8_t lightmapBuffer[TILE_WIDTH * TILE_HEIGHT];
-	const Lightmap bleedLightmap = Lightmap::bleedUp(*GetOptions().Graphics.perPixelLighting, lightmap, targetBufferPosition, lightmapBuffer);
+	const Lightmap bleedLightmap = Lightmap::bleedUp(*GetOptions().Graphics.perPixelLighting, lightmap, targetBufferPosition + RenderOrigin, lightmapBuffer);
 
 	// If the first micro tile is a floor tile, it may be followed
 	// by foliage which should be rendered now.
@@ -728,7 +790,8 @@ void DrawMonsterHelper(const Surface &out, Point tilePosition, Point targetBuffe
 
 	const Point monsterRenderPosition = targetBufferPosition + offset;
 	if (mi == pcursmonst) {
-		ClxDrawOutlineSkipColorZero(out, 233, monsterRenderPosition, sprite);
+		// The type's TRN can map colors to index 0, which the outline treats as transparent
+		ClxDrawOutlineSkipColorZeroTRN(out, 233, monsterRenderPosition, sprite, monster.type().getTRN(*monster.animInfo.sprites));
 	}
 	DrawMonster(out, tilePosition, monsterRenderPosition, monster, lightTableIndex);
 }
@@ -766,9 +829,9 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		const ClxSprite sprite = corpse.spritesForDirection(static_cast<Direction>((bDead >> 5) & 7))[corpse.frame];
 		if (corpse.translationPaletteIndex != 0) {
 			const uint8_t *trn = Monsters[corpse.translationPaletteIndex - 1].uniqueMonsterTRN.get();
-			ClxDrawTRN(out, position, sprite, trn);
+			ClxDrawMonsterTRN(out, position, sprite, corpse.trn, trn);
 		} else {
-			ClxDrawLight(out, position, sprite, lightTableIndex);
+			ClxDrawMonsterLight(out, position, sprite, corpse.trn, lightTableIndex);
 		}
 	}
 
@@ -881,7 +944,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 			if (perPixelLighting) {
 				// Create a special lightmap buffer to bleed light up walls
 				uint8_t lightmapBuffer[TILE_WIDTH * TILE_HEIGHT];
-				const Lightmap bleedLightmap = Lightmap::bleedUp(*GetOptions().Graphics.perPixelLighting, lightmap, targetBufferPosition, lightmapBuffer);
+				const Lightmap bleedLightmap = Lightmap::bleedUp(*GetOptions().Graphics.perPixelLighting, lightmap, targetBufferPosition + RenderOrigin, lightmapBuffer);
 
 				if (transparency)
 					ClxDrawBlendedWithLightmap(out, targetBufferPosition, (*pSpecialCels)[bArch], bleedLightmap);
@@ -897,7 +960,7 @@ void DrawDungeon(const Surface &out, const Lightmap &lightmap, Point tilePositio
 		// Tree leaves should always cover player when entering or leaving the tile,
 		// So delay the rendering until after the next row is being drawn.
 		// This could probably have been better solved by sprites in screen space.
-		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y > TILE_HEIGHT) {
+		if (tilePosition.x > 0 && tilePosition.y > 0 && targetBufferPosition.y + RenderOrigin.deltaY > TILE_HEIGHT) {
 			const int8_t bArch = dSpecial[tilePosition.x - 1][tilePosition.y - 1] - 1;
 			if (bArch >= 0)
 				ClxDraw(out, targetBufferPosition + Displacement { 0, -TILE_HEIGHT }, (*pSpecialCels)[bArch]);
@@ -918,6 +981,10 @@ void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition,
 {
 	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
+			if (targetBufferPosition.x + TILE_WIDTH <= 0 || targetBufferPosition.x >= out.w()
+			    || targetBufferPosition.y < 0 || targetBufferPosition.y - TILE_HEIGHT >= out.h()) {
+				continue;
+			}
 			if (!InDungeonBounds(tilePosition)) {
 				world_draw_black_tile(out, targetBufferPosition.x, targetBufferPosition.y);
 				continue;
@@ -944,6 +1011,16 @@ void DrawFloor(const Surface &out, const Lightmap &lightmap, Point tilePosition,
 	}
 }
 
+/**
+ * @brief Checks whether anything drawn for the tile at the given buffer position can end up inside the buffer.
+ */
+[[nodiscard]] bool CanTileContentReach(const Surface &out, Point targetBufferPosition)
+{
+	return targetBufferPosition.y + 2 * TILE_HEIGHT >= 0
+	    && targetBufferPosition.x + TILE_WIDTH + MaxSpriteOverhang >= 0
+	    && targetBufferPosition.x - MaxSpriteOverhang < out.w();
+}
+
 /**
  * @brief Renders the floor tiles
  * @param out Output buffer
@@ -970,7 +1047,8 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 #ifdef _DEBUG
 				DebugCoordsMap[tilePosition.x + tilePosition.y * MAXDUNX] = targetBufferPosition;
 #endif
-				if (tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + TILE_WIDTH <= gnScreenWidth) {
+				const bool inView = CanTileContentReach(out, targetBufferPosition);
+				if (inView && tilePosition.x + 1 < MAXDUNX && tilePosition.y - 1 >= 0 && targetBufferPosition.x + RenderOrigin.deltaX + TILE_WIDTH <= gnScreenWidth) {
 					// Render objects behind walls first to prevent sprites, that are moving
 					// between tiles, from poking through the walls as they exceed the tile bounds.
 					// A proper fix for this would probably be to layout the scene and render by
@@ -982,7 +1060,7 @@ void DrawTileContent(const Surface &out, const Lightmap &lightmap, Point tilePos
 						}
 					}
 				}
-				if (!skip) {
+				if (inView && !skip) {
 					DrawDungeon(out, lightmap, tilePosition, targetBufferPosition);
 				}
 				skip = skipNext;
@@ -1113,6 +1191,505 @@ void CalcFirstTilePosition(Point &position, Displacement &offset)
 	}
 }
 
+/**
+ * @brief Everything besides the dungeon data and the sprites that changes what the game view looks like.
+ *
+ * The whole view is rendered again whenever any of this changes.
+ */
+struct ViewState {
+	Point position;
+	Displacement offset;
+	int rows;
+	int columns;
+	const std::byte *dungeonCels;
+	dungeon_type levelType;
+	uint8_t level;
+	bool setLevel;
+	int monsterUnderCursor;
+	int8_t itemUnderCursor;
+	const Object *objectUnderCursor;
+	const Player *playerUnderCursor;
+	bool showItemOutlines;
+	bool inStore;
+	bool infravision;
+	bool missilePreFlag;
+	bool perPixelLighting;
+#ifdef _DEBUG
+	bool transparencyDisabled;
+#endif
+
+	bool operator==(const ViewState &other) const = default;
+};
+
+/**
+ * @brief The dungeon data that decides how a tile is drawn.
+ *
+ * It is stored and compared as is rather than hashed, so that no change to it can be missed.
+ */
+struct TileState {
+	uint16_t piece = 0;
+	uint8_t light = 0;
+	uint8_t flags = 0;
+	int8_t corpse = 0;
+	bool transparent = false;
+	int8_t special = 0;
+	int8_t item = 0;
+	int8_t object = 0;
+	int16_t monster = 0;
+	int8_t player = 0;
+
+	bool operator==(const TileState &other) const = default;
+};
+
+/**
+ * @brief What was drawn for a visible tile the last time the game view was rendered.
+ */
+struct ViewTile {
+	TileState tileState;
+	/**
+	 * @brief Hash of the sprites drawn from the tile.
+	 *
+	 * If two different sets of sprites collide, the old sprites stay on screen until the tile changes again.
+	 * With 64 bits that is unlikely enough to not store the sprites themselves.
+	 */
+	uint64_t spriteHash = 0;
+	/** @brief Area of the view covered by those sprites. */
+	Rectangle spriteArea { { 0, 0 }, { 0, 0 } };
+};
+
+/** @brief The game view without the UI drawn on top of it, kept between frames for partial redraw. */
+std::optional<OwnedSurface> WorldLayer;
+std::optional<ViewState> LastViewState;
+std::vector<ViewTile> ViewTiles;
+DamagedAreaList DamagedAreas;
+
+constexpr uint64_t HashCombine(uint64_t hash, uint64_t value)
+{
+	return hash ^ (value + 0x9E3779B97F4A7C15U + (hash << 6) + (hash >> 2));
+}
+
+uint64_t HashCombine(uint64_t hash, const void *pointer)
+{
+	return HashCombine(hash, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)));
+}
+
+/**
+ * @brief Collects the sprites drawn from a single tile.
+ */
+struct TileSprites {
+	uint64_t hash = 0;
+	Rectangle area { { 0, 0 }, { 0, 0 } };
+
+	/**
+	 * @param sprite Sprite as passed to ClxDraw
+	 * @param position Bottom left corner of the sprite in the view
+	 * @param state Anything else that changes how the sprite is drawn
+	 * @param margin Extra space around the sprite that may be drawn to, e.g. by outlines
+	 */
+	void add(ClxSprite sprite, Point position, uint32_t state, Displacement margin = { 1, 1 })
+	{
+		hash = HashCombine(hash, sprite.pixelData());
+		hash = HashCombine(hash, static_cast<uint32_t>(position.x));
+		hash = HashCombine(hash, static_cast<uint32_t>(position.y));
+		hash = HashCombine(hash, state);
+		const Rectangle spriteArea {
+			{ position.x - margin.deltaX, position.y - sprite.height() + 1 - margin.deltaY },
+			{ sprite.width() + 2 * margin.deltaX, sprite.height() + 2 * margin.deltaY }
+		};
+		area = MergeDamagedAreas(area, spriteArea);
+	}
+};
+
+ViewState GetViewState(Point position, Displacement offset, int rows, int columns)
+{
+	return ViewState {
+		.position = position,
+		.offset = offset,
+		.rows = rows,
+		.columns = columns,
+		.dungeonCels = pDungeonCels.get(),
+		.levelType = leveltype,
+		.level = currlevel,
+		.setLevel = setlevel,
+		.monsterUnderCursor = pcursmonst,
+		.itemUnderCursor = pcursitem,
+		.objectUnderCursor = ObjectUnderCursor,
+		.playerUnderCursor = PlayerUnderCursor,
+		.showItemOutlines = AutoMapShowItems,
+		.inStore = IsPlayerInStore(),
+		.infravision = MyPlayer->_pInfraFlag || MyPlayer->isOnArenaLevel(),
+		.missilePreFlag = MissilePreFlag,
+		.perPixelLighting = *GetOptions().Graphics.perPixelLighting,
+#ifdef _DEBUG
+		.transparencyDisabled = (SDL_GetModState() & KMOD_ALT) != 0,
+#endif
+	};
+}
+
+TileState GetTileState(Point tilePosition)
+{
+	const int x = tilePosition.x;
+	const int y = tilePosition.y;
+	return TileState {
+		.piece = dPiece[x][y],
+		.light = dLight[x][y],
+		.flags = static_cast<uint8_t>(dFlags[x][y]),
+		.corpse = dCorpse[x][y],
+		.transparent = TransList[dTransVal[x][y]],
+		.special = dSpecial[x][y],
+		.item = dItem[x][y],
+		.object = dObject[x][y],
+		.monster = dMonster[x][y],
+		.player = dPlayer[x][y],
+	};
+}
+
+/**
+ * @brief Area of the view that can change along with the dungeon data of a tile.
+ *
+ * Covers the walls of the tile and, as per-pixel lighting blends the light of neighbouring tiles, the ones around it.
+ */
+Rectangle GetTileArea(Point tilePosition, Point targetBufferPosition)
+{
+	const int wallHeight = (MicroTileLen / 2 + 1) * TILE_HEIGHT;
+	Rectangle area {
+		{ targetBufferPosition.x - TILE_WIDTH, targetBufferPosition.y - wallHeight - TILE_HEIGHT },
+		{ 3 * TILE_WIDTH, wallHeight + 3 * TILE_HEIGHT }
+	};
+	const int8_t bArch = dSpecial[tilePosition.x][tilePosition.y] - 1;
+	if (leveltype != DTYPE_TOWN && bArch >= 0 && pSpecialCels) {
+		const ClxSprite sprite = (*pSpecialCels)[bArch];
+		area = MergeDamagedAreas(area, { { targetBufferPosition.x, targetBufferPosition.y - sprite.height() + 1 }, { sprite.width(), sprite.height() } });
+	}
+	return area;
+}
+
+void CollectTileSprites(TileSprites &sprites, WorldTilePosition tilePosition, Point targetBufferPosition)
+{
+	// Walking characters are drawn from the tile they move from, and players carry their mana shield and reflect icons with them
+	constexpr Displacement CharacterMargin { TILE_WIDTH, TILE_HEIGHT };
+
+	if (const auto it = MissilesAtRenderingTile.find(tilePosition); it != MissilesAtRenderingTile.end()) {
+		for (const Missile *missile : it->second) {
+			if (!missile->_miDrawFlag)
+				continue;
+			const ClxSprite sprite = (*missile->_miAnimData)[missile->_miAnimFrame - 1];
+			const uint32_t state = (missile->_miPreFlag ? 1 : 0) | (missile->_miLightFlag ? 2 : 0) | (missile->_miUniqTrans << 2);
+			sprites.add(sprite, targetBufferPosition + missile->position.offsetForRendering - Displacement { missile->_miAnimWidth2, 0 }, state);
+		}
+	}
+
+	const int8_t bItem = dItem[tilePosition.x][tilePosition.y];
+	if (bItem > 0) {
+		const Item &item = Items[bItem - 1];
+		const ClxSprite sprite = item.AnimInfo.currentSprite();
+		sprites.add(sprite, targetBufferPosition + item.getRenderingOffset(sprite), item._iPostDraw ? 1 : 0);
+	}
+
+	if (dLight[tilePosition.x][tilePosition.y] < LightsMax) {
+		if (const Object *object = FindObjectAtPosition(tilePosition); object != nullptr) {
+			const ClxSprite sprite = object->currentSprite();
+			sprites.add(sprite, targetBufferPosition + object->getRenderingOffset(sprite, tilePosition), (object->_oPreFlag ? 1 : 0) | (object->applyLighting ? 2 : 0));
+		}
+	}
+
+	const auto addPlayer = [&](const Player &player) {
+		const ClxSprite sprite = player.currentSprite();
+		const uint32_t state = static_cast<uint32_t>(player._pmode)
+		    | (static_cast<uint32_t>(player._pdir) << 8)
+		    | (player.pManaShield ? 1U << 16 : 0)
+		    | (player.wReflections > 0 ? 1U << 17 : 0);
+		sprites.add(sprite, targetBufferPosition + player.getRenderingOffset(sprite), state, CharacterMargin);
+	};
+	if (TileContainsDeadPlayer(tilePosition)) {
+		for (const Player &player : Players) {
+			if (player.plractive && player._pHitPoints == 0 && player.isOnActiveLevel() && player.position.tile == tilePosition)
+				addPlayer(player);
+		}
+	}
+	if (dPlayer[tilePosition.x][tilePosition.y] != 0) {
+		if (const Player *player = PlayerAtPosition(tilePosition); player != nullptr)
+			addPlayer(*player);
+	}
+
+	const int mi = std::abs(dMonster[tilePosition.x][tilePosition.y]) - 1;
+	if (mi < 0)
+		return;
+	if (leveltype == DTYPE_TOWN) {
+		if (mi < NUM_TOWNERS) {
+			const Towner &towner = Towners[mi];
+			sprites.add(towner.currentSprite(), targetBufferPosition + towner.getRenderingOffset(), 0, CharacterMargin);
+		}
+		return;
+	}
+	if (const Monster *monster = FindMonsterAtPosition(tilePosition); monster != nullptr && monster->animInfo.sprites) {
+		const ClxSprite sprite = monster->animInfo.currentSprite();
+		const uint32_t state = static_cast<uint32_t>(monster->mode)
+		    | (static_cast<uint32_t>(monster->direction) << 8)
+		    | ((monster->flags & MFLAG_HIDDEN) != 0 ? 1U << 16 : 0);
+		sprites.add(sprite, targetBufferPosition + monster->getRenderingOffset(sprite), state, CharacterMargin);
+	}
+}
+
+/**
+ * @brief Compares what every visible tile draws with the previous frame and records the areas of the view that changed.
+ */
+void CollectDamagedAreas(Point tilePosition, Point targetBufferPosition, int rows, int columns, bool redrawAll)
+{
+	DamagedAreas.clear();
+	const Rectangle viewArea { { 0, 0 }, { gnScreenWidth, gnViewportHeight } };
+
+	// Walk the same tiles as DrawTileContent
+	rows += MicroTileLen;
+	const int stride = columns + 1;
+	const size_t tileCount = static_cast<size_t>(rows * stride);
+	if (ViewTiles.size() != tileCount) {
+		ViewTiles.assign(tileCount, ViewTile {});
+		redrawAll = true;
+	}
+
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < columns; j++) {
+			ViewTile &viewTile = ViewTiles[(i * stride) + j];
+			TileState tileState;
+			TileSprites sprites;
+			if (InDungeonBounds(tilePosition)) {
+				tileState = GetTileState(tilePosition);
+				CollectTileSprites(sprites, tilePosition, targetBufferPosition);
+			}
+			if (!redrawAll) {
+				if (tileState != viewTile.tileState) {
+					AddDamagedArea(DamagedAreas, MergeDamagedAreas(GetTileArea(tilePosition, targetBufferPosition), MergeDamagedAreas(viewTile.spriteArea, sprites.area)), viewArea);
+				} else if (sprites.hash != viewTile.spriteHash) {
+					AddDamagedArea(DamagedAreas, MergeDamagedAreas(viewTile.spriteArea, sprites.area), viewArea);
+				}
+			}
+			viewTile = ViewTile { tileState, sprites.hash, sprites.area };
+			tilePosition += Direction::East;
+			targetBufferPosition.x += TILE_WIDTH;
+		}
+		// Return to start of row
+		tilePosition += Displacement(Direction::West) * columns;
+		targetBufferPosition.x -= columns * TILE_WIDTH;
+
+		// Jump to next row
+		targetBufferPosition.y += TILE_HEIGHT / 2;
+		if ((i & 1) != 0) {
+			tilePosition.x++;
+			columns--;
+			targetBufferPosition.x += TILE_WIDTH / 2;
+		} else {
+			tilePosition.y++;
+			columns++;
+			targetBufferPosition.x -= TILE_WIDTH / 2;
+		}
+	}
+
+	if (redrawAll) {
+		DamagedAreas.clear();
+		DamagedAreas.push_back(viewArea);
+	}
+}
+
+/**
+ * @brief Everything besides the floor tiles themselves that changes what the floor layer looks like.
+ *
+ * The whole floor layer is rendered again whenever any of this changes.
+ */
+struct FloorLayerState {
+	Point position;
+	Displacement offset;
+	int rows;
+	int columns;
+	const std::byte *dungeonCels;
+	dungeon_type levelType;
+	uint8_t level;
+	bool setLevel;
+	bool perPixelLighting;
+
+	bool operator==(const FloorLayerState &other) const = default;
+};
+
+/** @brief The floor of the game view, kept between frames so that only changed floor tiles need to be rendered. */
+std::optional<OwnedSurface> FloorLayer;
+std::optional<FloorLayerState> LastFloorLayerState;
+/** @brief Key of each visible floor tile as of the last time it was rendered to the floor layer. */
+std::vector<uint64_t> FloorTileKeys;
+
+/**
+ * @brief Allocates or releases the floor layer depending on whether the floor cache can be used this frame.
+ * @return Whether the floor should be drawn from the floor layer
+ */
+bool PrepareFloorLayer()
+{
+	bool useFloorLayer = *GetOptions().Graphics.floorCache;
+#ifdef _DEBUG
+	// The path overlay is drawn into the floor tiles
+	useFloorLayer = useFloorLayer && !DebugPath;
+#endif
+	if (!useFloorLayer) {
+		FloorLayer = std::nullopt;
+		return false;
+	}
+	if (!FloorLayer || FloorLayer->w() != gnScreenWidth || FloorLayer->h() != gnViewportHeight) {
+		FloorLayer.emplace(gnScreenWidth, gnViewportHeight);
+		LastFloorLayerState = std::nullopt;
+	}
+	return true;
+}
+
+/**
+ * @brief Gets a key that changes whenever the rendered floor tile would change.
+ *
+ * The key is a 64-bit hash, so a stale floor tile left by a collision is unlikely enough to be accepted.
+ */
+uint64_t GetFloorTileKey(Point tilePosition, bool perPixelLighting)
+{
+	if (!InDungeonBounds(tilePosition))
+		return 0;
+
+	uint64_t key = HashCombine(dPiece[tilePosition.x][tilePosition.y], dLight[tilePosition.x][tilePosition.y]);
+	if (perPixelLighting) {
+		// The lightmap blends the light of the tile with that of its neighbours
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				const Point neighbour = tilePosition + Displacement { dx, dy };
+				key = HashCombine(key, InDungeonBounds(neighbour) ? dLight[neighbour.x][neighbour.y] : LightsMax);
+			}
+		}
+	}
+	return key;
+}
+
+/**
+ * @brief Renders the floor tiles that changed since the last frame to the floor layer.
+ * @param frameLightmap Lightmap built for this frame
+ * @param tilePosition dPiece coordinates of the first tile of the view
+ * @param offset Amount to offset the rendering in screen space
+ * @param rows Number of rows
+ * @param columns Tile in a row
+ */
+void UpdateFloorLayer(const Lightmap &frameLightmap, Point tilePosition, Displacement offset, int rows, int columns)
+{
+	const Surface &layer = *FloorLayer;
+	const bool perPixelLighting = *GetOptions().Graphics.perPixelLighting;
+
+	const FloorLayerState state {
+		.position = tilePosition,
+		.offset = offset,
+		.rows = rows,
+		.columns = columns,
+		.dungeonCels = pDungeonCels.get(),
+		.levelType = leveltype,
+		.level = currlevel,
+		.setLevel = setlevel,
+		.perPixelLighting = perPixelLighting,
+	};
+	bool redrawAll = state != LastFloorLayerState;
+	LastFloorLayerState = state;
+
+	const int stride = columns + 1;
+	const size_t tileCount = static_cast<size_t>(rows) * stride;
+	if (FloorTileKeys.size() != tileCount) {
+		FloorTileKeys.assign(tileCount, 0);
+		redrawAll = true;
+	}
+	if (redrawAll)
+		SDL_FillRect(layer.surface, nullptr, 0);
+
+	const Lightmap lightmap = frameLightmap.forBuffer(layer.at(0, 0), layer.pitch());
+	Point targetBufferPosition = Point {} + offset;
+	for (int i = 0; i < rows; i++) {
+		uint64_t *keys = &FloorTileKeys[static_cast<size_t>(i) * stride];
+		for (int j = 0; j < columns; j++, tilePosition += Direction::East, targetBufferPosition.x += TILE_WIDTH) {
+			if (targetBufferPosition.x + TILE_WIDTH <= 0 || targetBufferPosition.x >= layer.w()
+			    || targetBufferPosition.y < 0 || targetBufferPosition.y - TILE_HEIGHT >= layer.h()) {
+				continue;
+			}
+			const uint64_t key = GetFloorTileKey(tilePosition, perPixelLighting);
+			if (!redrawAll && keys[j] == key)
+				continue;
+			keys[j] = key;
+			if (InDungeonBounds(tilePosition) && IsFloor(tilePosition)) {
+				DrawFloorTile(layer, lightmap, tilePosition, targetBufferPosition);
+			} else {
+				// Also clears whatever floor tile used to be here
+				world_draw_black_tile(layer, targetBufferPosition.x, targetBufferPosition.y);
+			}
+		}
+		// Return to start of row
+		tilePosition += Displacement(Direction::West) * columns;
+		targetBufferPosition.x -= columns * TILE_WIDTH;
+
+		// Jump to next row
+		targetBufferPosition.y += TILE_HEIGHT / 2;
+		if ((i & 1) != 0) {
+			tilePosition.x++;
+			columns--;
+			targetBufferPosition.x += TILE_WIDTH / 2;
+		} else {
+			tilePosition.y++;
+			columns++;
+			targetBufferPosition.x -= TILE_WIDTH / 2;
+		}
+	}
+}
+
+/**
+ * @brief Copies the part of the floor layer covered by the given buffer, see RenderOrigin.
+ */
+void DrawFloorLayer(const Surface &out)
+{
+	out.BlitFrom(*FloorLayer, MakeSdlRect(RenderOrigin.deltaX, RenderOrigin.deltaY, out.w(), out.h()), { 0, 0 });
+}
+
+/**
+ * @brief Renders the areas of the view that changed since the last frame to the world layer, then copies the whole layer to the output.
+ */
+void DrawDamagedAreas(const Surface &out, Point position, Displacement offset, int rows, int columns, bool useFloorLayer)
+{
+	if (!WorldLayer || WorldLayer->w() != gnScreenWidth || WorldLayer->h() != gnViewportHeight) {
+		WorldLayer.emplace(gnScreenWidth, gnViewportHeight);
+		LastViewState = std::nullopt;
+	}
+	const Surface &layer = *WorldLayer;
+
+	const ViewState viewState = GetViewState(position, offset, rows, columns);
+	// Item labels are queued while drawing the items, so they need every item to be drawn
+	bool redrawAll = IsRedrawEverything() || viewState != LastViewState || IsHighlightingLabelsEnabled();
+#ifdef _DEBUG
+	redrawAll = redrawAll || DebugVision || DebugPath || DebugGrid || IsDebugGridTextNeeded();
+#endif
+	LastViewState = viewState;
+
+	CollectDamagedAreas(position, Point {} + offset, rows, columns, redrawAll);
+
+	if (!DamagedAreas.empty()) {
+		const Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
+		    gnScreenWidth, gnViewportHeight, rows, columns,
+		    layer.at(0, 0), layer.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
+		    dLight, MicroTileLen);
+		if (useFloorLayer)
+			UpdateFloorLayer(lightmap, position, offset, rows, columns);
+
+		for (const Rectangle &area : DamagedAreas) {
+			SDL_Rect fillRect = MakeSdlRect(area);
+			SDL_FillRect(layer.surface, &fillRect, 0);
+
+			const Surface areaOut = layer.subregion(area.position.x, area.position.y, area.size.width, area.size.height);
+			RenderOrigin = area.position - Point { 0, 0 };
+			if (useFloorLayer)
+				DrawFloorLayer(areaOut);
+			else
+				DrawFloor(areaOut, lightmap, position, Point {} + offset - RenderOrigin, rows, columns);
+			DrawTileContent(areaOut, lightmap, position, Point {} + offset - RenderOrigin, rows, columns);
+		}
+		RenderOrigin = {};
+	}
+
+	out.BlitFrom(layer, MakeSdlRect(0, 0, layer.w(), layer.h()), { 0, 0 });
+}
+
 /**
  * @brief Configure render and process screen rows
  * @param fullOut Buffer to render to
@@ -1166,13 +1743,25 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
 	DunRenderStats.clear();
 #endif
 
-	Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
-	    gnScreenWidth, gnViewportHeight, rows, columns,
-	    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
-	    dLight, MicroTileLen);
+	const bool useFloorLayer = PrepareFloorLayer();
+	if (*GetOptions().Graphics.partialRedraw && !*GetOptions().Graphics.zoom) {
+		DrawDamagedAreas(out, position, offset, rows, columns, useFloorLayer);
+	} else {
+		WorldLayer = std::nullopt;
 
-	DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
-	DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
+		const Lightmap lightmap = Lightmap::build(*GetOptions().Graphics.perPixelLighting, position, Point {} + offset,
+		    gnScreenWidth, gnViewportHeight, rows, columns,
+		    out.at(0, 0), out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable,
+		    dLight, MicroTileLen);
+
+		if (useFloorLayer) {
+			UpdateFloorLayer(lightmap, position, offset, rows, columns);
+			DrawFloorLayer(out);
+		} else {
+			DrawFloor(out, lightmap, position, Point {} + offset, rows, columns);
+		}
+		DrawTileContent(out, lightmap, position, Point {} + offset, rows, columns);
+	}
 
 	if (*GetOptions().Graphics.zoom) {
 		Zoom(fullOut.subregionY(0, gnViewportHeight));
@@ -1204,6 +1793,7 @@ void DrawGame(const Surface &fullOut, Point position, Displacement offset)
  */
 void DrawView(const Surface &out, Point startPosition)
 {
+	DVL_PROFILE_ZONE(DrawView);
 #ifdef _DEBUG
 	DebugCoordsMap.clear();
 #endif
@@ -1372,6 +1962,36 @@ void DrawFPS(const Surface &out)
 	DrawString(out, formatted, Point { 8, 68 }, { .flags = UiFlags::ColorRed });
 }
 
+#ifdef DEVILUTIONX_PROFILER
+/**
+ * @brief Display the average time per frame spent in each profiler zone, below the FPS
+ */
+void DrawProfilerZones(const Surface &out)
+{
+	profiler::EndFrame();
+
+	if (!frameflag || !gbActive) {
+		return;
+	}
+
+	Point position { 8, 68 };
+	for (size_t i = 0; i < profiler::NumZones; i++) {
+		const auto zone = static_cast<profiler::Zone>(i);
+		const uint32_t microseconds = profiler::GetZoneMicrosecondsPerFrame(zone);
+		char buf[64] {};
+		const char *end = BufCopy(buf, profiler::ZoneName(zone), ": ", microseconds / 1000, ".", microseconds / 100 % 10, " ms");
+		position.y += 12;
+		DrawString(out, { buf, static_cast<std::string_view::size_type>(end - buf) }, position, { .flags = UiFlags::ColorRed });
+	}
+}
+#endif
+
+/**
+ * @brief Copy of the back buffer as of the last blit, used to only blit what changed when partial redraw is enabled.
+ */
+std::optional<OwnedSurface> PresentedFrame;
+std::array<SDL_Color, 256> PresentedPalette;
+
 /**
  * @brief Update part of the screen from the back buffer
  */
@@ -1388,6 +2008,30 @@ void DoBlitScreen(Rectangle area)
 	SDL_Rect srcRect = MakeSdlRect(area);
 	SDL_Rect dstRect = MakeSdlRect(area);
 	BltFast(&srcRect, &dstRect);
+	if (PresentedFrame)
+		PresentedFrame->BlitFrom(GlobalBackBuffer(), MakeSdlRect(area), area.position);
+}
+
+/**
+ * @brief Blits the rows at the top of the back buffer that differ from what was blitted before.
+ * @param height Number of rows to check
+ */
+void BlitChangedRows(int height)
+{
+	const Surface out = GlobalBackBuffer();
+
+	// Fades and color cycling change the palette without touching the back buffer
+	if (!PresentedFrame || PresentedFrame->w() != out.w() || PresentedFrame->h() != out.h() || IsRedrawEverything()
+	    || memcmp(PresentedPalette.data(), system_palette.data(), sizeof(PresentedPalette)) != 0) {
+		PresentedFrame.emplace(out.w(), out.h());
+		PresentedPalette = system_palette;
+		DoBlitScreen({ { 0, 0 }, { out.w(), out.h() } });
+		return;
+	}
+
+	ForEachChangedRowBand(out, *PresentedFrame, height, [&out](int top, int bottom) {
+		DoBlitScreen({ { 0, top }, { out.w(), bottom - top } });
+	});
 }
 
 /**
@@ -1402,6 +2046,7 @@ void DoBlitScreen(Rectangle area)
  */
 void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSbar, bool drawBtn)
 {
+	DVL_PROFILE_ZONE(DrawMain);
 	if (!gbActive || RenderDirectlyToOutputSurface) {
 		return;
 	}
@@ -1409,7 +2054,12 @@ void DrawMain(int dwHgt, bool drawDesc, bool drawHp, bool drawMana, bool drawSba
 	assert(dwHgt >= 0 && dwHgt <= gnScreenHeight);
 
 	if (dwHgt > 0) {
-		DoBlitScreen({ { 0, 0 }, { gnScreenWidth, dwHgt } });
+		if (*GetOptions().Graphics.partialRedraw) {
+			BlitChangedRows(dwHgt);
+		} else {
+			PresentedFrame = std::nullopt;
+			DoBlitScreen({ { 0, 0 }, { gnScreenWidth, dwHgt } });
+		}
 	}
 	if (dwHgt < gnScreenHeight) {
 		const Point mainPanelPosition = GetMainPanel().position;
@@ -1621,6 +2271,13 @@ Point GetScreenPosition(Point tile)
 	return position;
 }
 
+void DrawDungeonView(const Surface &out, Point startPosition)
+{
+	Displacement offset = {};
+	CalcFirstTilePosition(startPosition, offset);
+	DrawGame(out, startPosition, offset);
+}
+
 extern SDL_Surface *PalSurface;
 
 void ClearScreenBuffer()
@@ -1792,6 +2449,9 @@ void DrawAndBlit()
 	DrawCursor(out);
 
 	DrawFPS(out);
+#ifdef DEVILUTIONX_PROFILER
+	DrawProfilerZones(out);
+#endif
 
 	LuaEvent("GameDrawComplete");
 
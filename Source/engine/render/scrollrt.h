@@ -63,6 +63,13 @@ void CalcViewportGeometry();
  */
 Point GetScreenPosition(Point tile);
 
+/**
+ * @brief Render the dungeon as seen from the given tile, without any of the UI drawn on top of it
+ * @param out Buffer to render to
+ * @param startPosition Tile at the center of the view
+ */
+void DrawDungeonView(const Surface &out, Point startPosition);
+
 /**
  * @brief Render the whole screen black
  */
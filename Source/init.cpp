@@ -31,6 +31,7 @@
 #include "utils/utf8.hpp"
 
 #ifndef UNPACKED_MPQS
+#include "mpq/mpq_block_cache.hpp"
 #include "mpq/mpq_common.hpp"
 #include "mpq/mpq_reader.hpp"
 #endif
@@ -118,7 +119,12 @@ void init_cleanup()
 		sfile_write_stash();
 	}
 
+#ifndef UNPACKED_MPQS
+	const MpqBlockCacheStats blockCacheStats = GetMpqBlockCacheStats();
+	LogVerbose("MPQ block cache: {} hits, {} misses, {} evictions", blockCacheStats.hits, blockCacheStats.misses, blockCacheStats.evictions);
+#endif
 	MpqArchives.clear();
+	InvalidateAssetIndex();
 	HasHellfireMpq = false;
 
 	NetClose();
@@ -13,6 +13,7 @@
 
 #include "control.h"
 #include "controls/input.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/dx.h"
 #include "engine/events.hpp"
@@ -393,6 +394,9 @@ void DoLoad(interface_mode uMsg)
 		break;
 	}
 
+	// Loading may have stopped early with assets still being prefetched.
+	FinishAssetPrefetch();
+
 	if (!loadResult.has_value()) {
 		SDL_Event event;
 		CustomEventToSdlEvent(event, WM_ERROR);
@@ -6,6 +6,9 @@
 
 #include "itemdat.h"
 
+#include <array>
+#include <bit>
+#include <cassert>
 #include <string_view>
 #include <vector>
 
@@ -691,6 +694,56 @@ void LoadItemAffixesDat(std::string_view filename, std::vector<PLStruct> &out)
 	out.shrink_to_fit();
 }
 
+constexpr size_t NumAffixItemTypes = 6;
+constexpr size_t NumAffixCandidateLists = 2 * NumAffixItemTypes * 2 * 3 * 2;
+
+/** Affixes that may roll for each combination of affix list, item type and filters, see `AffixCandidatesIndex`. */
+std::array<std::vector<const PLStruct *>, NumAffixCandidateLists> AffixCandidates;
+
+size_t AffixCandidatesIndex(bool suffixes, size_t typeIndex, bool onlygood, goodorevil goe, bool excludeChargesForStaffs)
+{
+	size_t index = suffixes ? 1 : 0;
+	index = index * NumAffixItemTypes + typeIndex;
+	index = index * 2 + (onlygood ? 1 : 0);
+	index = index * 3 + static_cast<size_t>(goe);
+	index = index * 2 + (excludeChargesForStaffs ? 1 : 0);
+	return index;
+}
+
+bool IsAffixCandidate(const PLStruct &affix, AffixItemType type, bool onlygood, goodorevil goe, bool excludeChargesForStaffs)
+{
+	if (!HasAnyOf(type, affix.PLIType))
+		return false;
+	if (onlygood && !affix.PLOk)
+		return false;
+	if ((goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
+		return false;
+	if (excludeChargesForStaffs && type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
+		return false;
+	return true;
+}
+
+void BuildAffixCandidates(bool suffixes)
+{
+	const std::vector<PLStruct> &affixList = suffixes ? ItemSuffixes : ItemPrefixes;
+	for (size_t typeIndex = 0; typeIndex < NumAffixItemTypes; typeIndex++) {
+		const auto type = static_cast<AffixItemType>(1 << typeIndex);
+		for (const bool onlygood : { false, true }) {
+			for (const goodorevil goe : { GOE_ANY, GOE_EVIL, GOE_GOOD }) {
+				for (const bool excludeCharges : { false, true }) {
+					std::vector<const PLStruct *> &candidates = AffixCandidates[AffixCandidatesIndex(suffixes, typeIndex, onlygood, goe, excludeCharges)];
+					candidates.clear();
+					for (const PLStruct &affix : affixList) {
+						if (IsAffixCandidate(affix, type, onlygood, goe, excludeCharges))
+							candidates.push_back(&affix);
+					}
+					candidates.shrink_to_fit();
+				}
+			}
+		}
+	}
+}
+
 } // namespace
 
 void LoadItemData()
@@ -699,6 +752,17 @@ void LoadItemData()
 	LoadUniqueItemDat();
 	LoadItemAffixesDat("txtdata\\items\\item_prefixes.tsv", ItemPrefixes);
 	LoadItemAffixesDat("txtdata\\items\\item_suffixes.tsv", ItemSuffixes);
+	BuildAffixCandidates(/*suffixes=*/false);
+	BuildAffixCandidates(/*suffixes=*/true);
+}
+
+std::span<const PLStruct *const> GetAffixCandidates(const std::vector<PLStruct> &affixList, AffixItemType type, bool onlygood, goodorevil goe, bool excludeChargesForStaffs)
+{
+	assert(&affixList == &ItemPrefixes || &affixList == &ItemSuffixes);
+	const auto typeBits = static_cast<uint8_t>(type);
+	assert(std::has_single_bit(typeBits));
+	const auto typeIndex = static_cast<size_t>(std::countr_zero(typeBits));
+	return AffixCandidates[AffixCandidatesIndex(&affixList == &ItemSuffixes, typeIndex, onlygood, goe, excludeChargesForStaffs)];
 }
 
 std::string_view ItemTypeToString(ItemType itemType)
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -658,4 +659,14 @@ void LoadItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t
 void LoadUniqueItemDatFromFile(DataFile &dataFile, std::string_view filename, int32_t baseMappingId);
 void LoadItemData();
 
+/**
+ * @brief Returns the affixes of `affixList` that may roll on an item of the given type, regardless of level, in list order.
+ *
+ * The candidates are computed once when the item data is loaded.
+ *
+ * @param affixList Either `ItemPrefixes` or `ItemSuffixes`.
+ * @param type A single item type flag.
+ */
+std::span<const PLStruct *const> GetAffixCandidates(const std::vector<PLStruct> &affixList, AffixItemType type, bool onlygood, goodorevil goe, bool excludeChargesForStaffs);
+
 } // namespace devilution
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cstring>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -81,7 +82,6 @@
 #include "utils/log.hpp"
 #include "utils/math.h"
 #include "utils/sdl_geometry.h"
-#include "utils/static_vector.hpp"
 #include "utils/str_cat.hpp"
 #include "utils/str_split.hpp"
 #include "utils/string_or_view.hpp"
@@ -1063,29 +1063,31 @@ std::optional<const PLStruct *> SelectAffix(
     goodorevil goe,
     bool excludeChargesForStaffs)
 {
-	StaticVector<const PLStruct *, 256> eligibleAffixes;
+	const std::span<const PLStruct *const> candidates = GetAffixCandidates(affixList, type, onlygood, goe, excludeChargesForStaffs);
 
-	for (const PLStruct &affix : affixList) {
-		if (!HasAnyOf(type, affix.PLIType))
-			continue;
-		if (affix.PLMinLvl < minlvl || affix.PLMinLvl > maxlvl)
-			continue;
-		if (onlygood && !affix.PLOk)
-			continue;
-		if ((goe == GOE_GOOD && affix.PLGOE == GOE_EVIL) || (goe == GOE_EVIL && affix.PLGOE == GOE_GOOD))
-			continue;
-		if (excludeChargesForStaffs && type == AffixItemType::Staff && affix.power.type == IPL_CHARGES)
-			continue;
+	const auto isInLevelRange = [&](const PLStruct &affix) {
+		return affix.PLMinLvl >= minlvl && affix.PLMinLvl <= maxlvl;
+	};
 
-		for (int i = 0; i < affix.PLChance; ++i) {
-			eligibleAffixes.push_back(&affix);
-		}
+	// Each affix is weighted by its chance, as if it was listed that many times.
+	int totalChance = 0;
+	for (const PLStruct *affix : candidates) {
+		if (isInLevelRange(*affix))
+			totalChance += affix->PLChance;
 	}
 
-	if (eligibleAffixes.empty())
+	if (totalChance == 0)
 		return std::nullopt;
 
-	return eligibleAffixes[GenerateRnd(static_cast<int>(eligibleAffixes.size()))];
+	int roll = GenerateRnd(totalChance);
+	for (const PLStruct *affix : candidates) {
+		if (!isInLevelRange(*affix))
+			continue;
+		if (roll < affix->PLChance)
+			return affix;
+		roll -= affix->PLChance;
+	}
+	app_fatal("Affix roll out of range");
 }
 
 std::optional<const PLStruct *> GetStaffPrefix(int maxlvl, bool onlygood)
@@ -0,0 +1,93 @@
+#include "levels/distance_field.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "levels/gendung.h"
+#include "levels/tile_properties.hpp"
+#include "multi.h"
+#include "player.h"
+
+namespace devilution {
+
+namespace {
+
+struct DistanceField {
+	Point root;
+	/** The `FieldGeneration` the distances were computed in, 0 if never. */
+	uint32_t generation;
+	uint8_t steps[MAXDUNX][MAXDUNY];
+};
+
+std::array<DistanceField, MAX_PLRS> DistanceFields;
+uint32_t FieldGeneration = 1;
+
+/** Tiles to expand, reused between searches. */
+std::vector<Point> SearchQueue;
+
+/**
+ * @brief Breadth-first search from `root` over the tiles that can be walked on, up to `MaxPathLengthPlayer` steps away.
+ *
+ * Steps from the root are not checked for cutting corners, since `FindPath` does not check the step to a destination
+ * that cannot be walked on, such as the tile of a player.
+ */
+void ComputeDistances(DistanceField &field, Point root)
+{
+	std::fill(&field.steps[0][0], &field.steps[0][0] + MAXDUNX * MAXDUNY, UnreachableDistance);
+	field.root = root;
+	field.generation = FieldGeneration;
+
+	SearchQueue.clear();
+	SearchQueue.reserve(MAXDUNX * MAXDUNY);
+	field.steps[root.x][root.y] = 0;
+	SearchQueue.push_back(root);
+	for (size_t i = 0; i < SearchQueue.size(); i++) {
+		const Point position = SearchQueue[i];
+		const uint8_t steps = field.steps[position.x][position.y];
+		if (steps == MaxPathLengthPlayer)
+			continue;
+		for (const Displacement &direction : PathDirs) {
+			const Point next = position + direction;
+			if (!InDungeonBounds(next) || field.steps[next.x][next.y] != UnreachableDistance)
+				continue;
+			if (!IsTileEverWalkable(next) || (steps != 0 && !CanEverStep(position, next)))
+				continue;
+			field.steps[next.x][next.y] = static_cast<uint8_t>(steps + 1);
+			SearchQueue.push_back(next);
+		}
+	}
+}
+
+} // namespace
+
+uint8_t GetWalkingDistanceLowerBound(const Player &player, Point position)
+{
+	const Point root = player.position.future;
+	if (!InDungeonBounds(root) || !InDungeonBounds(position))
+		return 0;
+
+	DistanceField &field = DistanceFields[player.getId()];
+	if (field.generation != FieldGeneration || field.root != root)
+		ComputeDistances(field, root);
+
+	// A path may also end on a tile that cannot be walked on, with a last step that is not checked for cutting corners.
+	int steps = field.steps[position.x][position.y];
+	for (const Displacement &direction : PathDirs) {
+		const Point previous = position + direction;
+		if (InDungeonBounds(previous))
+			steps = std::min(steps, field.steps[previous.x][previous.y] + 1);
+	}
+	return static_cast<uint8_t>(std::min<int>(steps, UnreachableDistance));
+}
+
+void InvalidateDistanceFields()
+{
+	FieldGeneration++;
+}
+
+} // namespace devilution
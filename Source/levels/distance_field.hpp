@@ -0,0 +1,37 @@
+/**
+ * @file levels/distance_field.hpp
+ *
+ * Walking distances from each player, shared by everything that looks for a path to or from a player.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+struct Player;
+
+/** Distance of the positions that cannot be reached within `MaxPathLengthPlayer` steps. */
+constexpr uint8_t UnreachableDistance = UINT8_MAX;
+
+/**
+ * @brief Returns a lower bound of the number of steps between the player's future position and `position`.
+ *
+ * Only the layout of the level is taken into account: doors count as open, and monsters, players and other objects
+ * as absent. `FindPath` therefore never finds a path with fewer steps, so a path search between the two positions
+ * can be skipped when the bound already exceeds its maximum length.
+ *
+ * The distances from each player are computed when first needed, and reused until the player moves, the next game
+ * tick starts or the layout of the level changes.
+ *
+ * @return The number of steps, more than `MaxPathLengthPlayer` if there is no path of at most that many steps,
+ * or 0 if either position is outside of the dungeon.
+ */
+uint8_t GetWalkingDistanceLowerBound(const Player &player, Point position);
+
+/** @brief Discards the distances from all players. Called on every game tick and whenever the level layout changes. */
+void InvalidateDistanceFields();
+
+} // namespace devilution
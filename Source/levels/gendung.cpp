@@ -1,7 +1,9 @@
 #include "levels/gendung.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <stack>
 #include <string>
@@ -29,6 +31,7 @@
 #include "objects.h"
 #include "utils/algorithm/container.hpp"
 #include "utils/bitset2d.hpp"
+#include "utils/endian_read.hpp"
 #include "utils/is_of.hpp"
 #include "utils/log.hpp"
 #include "utils/status_macros.hpp"
@@ -72,6 +75,41 @@ THEME_LOC themeLoc[MAXTHEMES];
 
 namespace {
 
+/** @brief Re-encoded dungeon cels and micros of a tileset, kept across level changes. */
+struct DungeonMicrosCacheEntry {
+	dungeon_type levelType;
+	uint_fast8_t microTileLen;
+	std::unique_ptr<std::byte[]> dungeonCels;
+	size_t dungeonCelsSize;
+	std::vector<MICROS> micros;
+};
+
+/** Walking up and down the stairs between two tilesets never has to set them up again. */
+constexpr size_t MaxCachedTilesets = 2;
+
+/** @brief Most recently used first. */
+std::vector<DungeonMicrosCacheEntry> DungeonMicrosCache;
+
+void CacheDungeonMicros(const std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t microTileLen, size_t numMicros)
+{
+	const auto *offsets = reinterpret_cast<const uint8_t *>(dungeonCels.get());
+	const size_t size = LoadLE32(&offsets[4 * (LoadLE32(offsets) + 1)]);
+
+	DungeonMicrosCacheEntry entry { leveltype, microTileLen, std::unique_ptr<std::byte[]> { new std::byte[size] }, size, {} };
+	memcpy(entry.dungeonCels.get(), dungeonCels.get(), size);
+	entry.micros.assign(&DPieceMicros[0], &DPieceMicros[numMicros]);
+
+	std::erase_if(DungeonMicrosCache, [](const DungeonMicrosCacheEntry &cached) { return cached.levelType == leveltype; });
+	if (DungeonMicrosCache.size() == MaxCachedTilesets)
+		DungeonMicrosCache.pop_back();
+	DungeonMicrosCache.insert(DungeonMicrosCache.begin(), std::move(entry));
+}
+
+std::vector<DungeonMicrosCacheEntry>::iterator FindCachedDungeonMicros()
+{
+	return c_find_if(DungeonMicrosCache, [](const DungeonMicrosCacheEntry &entry) { return entry.levelType == leveltype; });
+}
+
 std::unique_ptr<uint16_t[]> LoadMinData(size_t &tileCount)
 {
 	switch (leveltype) {
@@ -543,19 +581,48 @@ void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &m
 	ReencodeDungeonCels(dungeonCels, frameToTypeList);
 
 	std::vector<std::pair<uint16_t, uint16_t>> celBlockAdjustments = ComputeCelBlockAdjustments(frameToTypeList);
-	if (celBlockAdjustments.size() == 0) return;
-	for (size_t levelPieceId = 0; levelPieceId < tileCount / blocks; levelPieceId++) {
-		for (uint32_t block = 0; block < blocks; block++) {
-			LevelCelBlock &levelCelBlock = DPieceMicros[levelPieceId].mt[block];
-			const uint16_t frame = levelCelBlock.frame();
-			const auto pair = std::make_pair(frame, frame);
-			const auto it = std::upper_bound(celBlockAdjustments.begin(), celBlockAdjustments.end(), pair,
-			    [](std::pair<uint16_t, uint16_t> p1, std::pair<uint16_t, uint16_t> p2) { return p1.first < p2.first; });
-			if (it != celBlockAdjustments.end()) {
-				levelCelBlock.data -= it->second;
+	if (celBlockAdjustments.size() != 0) {
+		for (size_t levelPieceId = 0; levelPieceId < tileCount / blocks; levelPieceId++) {
+			for (uint32_t block = 0; block < blocks; block++) {
+				LevelCelBlock &levelCelBlock = DPieceMicros[levelPieceId].mt[block];
+				const uint16_t frame = levelCelBlock.frame();
+				const auto pair = std::make_pair(frame, frame);
+				const auto it = std::upper_bound(celBlockAdjustments.begin(), celBlockAdjustments.end(), pair,
+				    [](std::pair<uint16_t, uint16_t> p1, std::pair<uint16_t, uint16_t> p2) { return p1.first < p2.first; });
+				if (it != celBlockAdjustments.end()) {
+					levelCelBlock.data -= it->second;
+				}
 			}
 		}
 	}
+
+	CacheDungeonMicros(dungeonCels, microTileLen, tileCount / blocks);
+}
+
+bool RestoreDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen)
+{
+	const auto it = FindCachedDungeonMicros();
+	if (it == DungeonMicrosCache.end())
+		return false;
+
+	dungeonCels = std::unique_ptr<std::byte[]> { new std::byte[it->dungeonCelsSize] };
+	memcpy(dungeonCels.get(), it->dungeonCels.get(), it->dungeonCelsSize);
+	std::copy(it->micros.begin(), it->micros.end(), &DPieceMicros[0]);
+	microTileLen = it->microTileLen;
+
+	std::rotate(DungeonMicrosCache.begin(), it, it + 1);
+	return true;
+}
+
+bool HasCachedDungeonMicros()
+{
+	return FindCachedDungeonMicros() != DungeonMicrosCache.end();
+}
+
+void FreeDungeonMicrosCache()
+{
+	DungeonMicrosCache.clear();
+	DungeonMicrosCache.shrink_to_fit();
 }
 
 void DRLG_InitTrans()
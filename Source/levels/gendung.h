@@ -5,8 +5,10 @@
  */
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -142,7 +144,7 @@ extern _setlevels setlvlnum;
 extern dungeon_type setlvltype;
 /** Specifies the player viewpoint X,Y-coordinates of the map. */
 extern DVL_API_FOR_TEST Point ViewPosition;
-extern uint_fast8_t MicroTileLen;
+extern DVL_API_FOR_TEST uint_fast8_t MicroTileLen;
 extern int8_t TransVal;
 /** Specifies the active transparency indices. */
 extern std::array<bool, 256> TransList;
@@ -157,16 +159,16 @@ extern DVL_API_FOR_TEST uint8_t dLight[MAXDUNX][MAXDUNY];
 /** Precalculated static lights. dLight uses this as a base before applying lights. Per tile. */
 extern uint8_t dPreLight[MAXDUNX][MAXDUNY];
 /** Holds various information about dungeon tiles, @see DungeonFlag */
-extern DungeonFlag dFlags[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST DungeonFlag dFlags[MAXDUNX][MAXDUNY];
 /** Contains the player numbers (players array indices) of the map. negative id indicates player moving. */
-extern int8_t dPlayer[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST int8_t dPlayer[MAXDUNX][MAXDUNY];
 /**
  * Contains the NPC numbers of the map. The NPC number represents a
  * towner number (towners array index) in Tristram and a monster number
  * (monsters array index) in the dungeon.
  * Negative id indicates monsters moving.
  */
-extern int16_t dMonster[MAXDUNX][MAXDUNY];
+extern DVL_API_FOR_TEST int16_t dMonster[MAXDUNX][MAXDUNY];
 /**
  * Contains the dead numbers (deads array indices) and dead direction of
  * the map, encoded as specified by the pseudo-code below.
@@ -257,23 +259,49 @@ constexpr bool IsTileLit(Point position)
 }
 
 struct Miniset {
+	/** @brief A column of tiles, in the same order as a column of `dungeon`, padded to be read as a single `uint64_t`. */
+	using Column = std::array<uint8_t, 8>;
+
 	WorldTileSize size;
 	/* these are indexed as [y][x] */
 	uint8_t search[6][6];
 	uint8_t replace[6][6];
 
+	/** The columns of `search`, computed from it. */
+	std::array<Column, 6> searchColumns = PackColumns(search, /*mask=*/false);
+	/** For each column of `search`, 0xFF for the tiles to match and 0 for the tiles that match anything. */
+	std::array<Column, 6> searchMasks = PackColumns(search, /*mask=*/true);
+
 	/**
 	 * @param position Coordinates of the dungeon tile to check
 	 * @param respectProtected Match bug from Crypt levels if false
 	 */
 	bool matches(WorldTilePosition position, bool respectProtected = true) const
 	{
-		for (WorldTileCoord yy = 0; yy < size.height; yy++) {
-			for (WorldTileCoord xx = 0; xx < size.width; xx++) {
-				if (search[yy][xx] != 0 && dungeon[xx + position.x][yy + position.y] != search[yy][xx])
-					return false;
-				if (respectProtected && Protected.test(xx + position.x, yy + position.y))
-					return false;
+		// Compare a whole column of the dungeon at once, masking out the tiles that match anything.
+		for (WorldTileCoord xx = 0; xx < size.width; xx++) {
+			const uint8_t *tiles = &dungeon[xx + position.x][position.y];
+			uint64_t dungeonColumn;
+			if (&dungeon[DMAXX - 1][DMAXY - 1] - tiles >= 7) {
+				std::memcpy(&dungeonColumn, tiles, sizeof(dungeonColumn));
+			} else {
+				Column column {};
+				std::memcpy(column.data(), tiles, size.height);
+				std::memcpy(&dungeonColumn, column.data(), sizeof(dungeonColumn));
+			}
+			uint64_t searchColumn;
+			uint64_t searchMask;
+			std::memcpy(&searchColumn, searchColumns[xx].data(), sizeof(searchColumn));
+			std::memcpy(&searchMask, searchMasks[xx].data(), sizeof(searchMask));
+			if ((dungeonColumn & searchMask) != searchColumn)
+				return false;
+		}
+		if (respectProtected) {
+			for (WorldTileCoord yy = 0; yy < size.height; yy++) {
+				for (WorldTileCoord xx = 0; xx < size.width; xx++) {
+					if (Protected.test(xx + position.x, yy + position.y))
+						return false;
+				}
 			}
 		}
 		return true;
@@ -291,6 +319,20 @@ struct Miniset {
 			}
 		}
 	}
+
+	static constexpr std::array<Column, 6> PackColumns(const uint8_t (&tiles)[6][6], bool mask)
+	{
+		std::array<Column, 6> columns {};
+		for (size_t x = 0; x < 6; x++) {
+			for (size_t y = 0; y < 6; y++) {
+				if (mask)
+					columns[x][y] = tiles[y][x] != 0 ? 0xFF : 0;
+				else
+					columns[x][y] = tiles[y][x];
+			}
+		}
+		return columns;
+	}
 };
 
 [[nodiscard]] DVL_ALWAYS_INLINE bool TileHasAny(Point coords, TileProperties property)
@@ -300,6 +342,23 @@ struct Miniset {
 
 tl::expected<void, std::string> LoadLevelSOLData();
 void SetDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen);
+
+/**
+ * @brief Restores the re-encoded dungeon cels and the micros of the current level type from an earlier `SetDungeonMicros`.
+ *
+ * @return false if the level type is not cached, in which case the cels have to be loaded and passed to `SetDungeonMicros`.
+ */
+bool RestoreDungeonMicros(std::unique_ptr<std::byte[]> &dungeonCels, uint_fast8_t &microTileLen);
+
+/**
+ * @brief Returns whether `RestoreDungeonMicros` will restore the current level type, so that its cels need not be loaded.
+ */
+bool HasCachedDungeonMicros();
+
+/**
+ * @brief Frees the dungeon cels and micros cached by `SetDungeonMicros`.
+ */
+void FreeDungeonMicrosCache();
 void DRLG_InitTrans();
 void DRLG_MRectTrans(WorldTilePosition origin, WorldTilePosition extent);
 void DRLG_MRectTrans(WorldTileRectangle area);
@@ -0,0 +1,279 @@
+#include "levels/room_graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "levels/gendung.h"
+#include "levels/tile_properties.hpp"
+
+namespace devilution {
+
+namespace {
+
+/** Width and height of the sectors the rooms are split along. */
+constexpr int SectorSize = 16;
+
+constexpr uint16_t NoRoom = 0;
+constexpr uint16_t NotSearched = UINT16_MAX;
+constexpr uint32_t NoPortal = UINT32_MAX;
+constexpr uint32_t Unreachable = UINT32_MAX;
+
+/** @brief A tile on the border of a room, next to a tile of another room. */
+struct Portal {
+	Point position;
+	uint16_t room;
+};
+
+/** @brief A way from a portal to another portal, either a step across the border or a walk through its room. */
+struct PortalLink {
+	uint32_t portal;
+	uint32_t steps;
+};
+
+/** Room of each tile, `NoRoom` for the tiles that can never be walked on. */
+uint16_t TileRooms[MAXDUNX][MAXDUNY];
+std::vector<Portal> Portals;
+/** Portals of each room, indexed by room. */
+std::vector<std::vector<uint32_t>> RoomPortals;
+/** Links of each portal, indexed by portal. */
+std::vector<std::vector<PortalLink>> PortalLinks;
+bool RoomGraphValid = false;
+
+/** Steps to each tile from the root of the last room search, `NotSearched` outside of it. */
+uint16_t RoomSteps[MAXDUNX][MAXDUNY];
+/** Tiles reached by the last room search, reused between searches. */
+std::vector<Point> SearchQueue;
+
+bool IsInSameRoom(Point position, Point next)
+{
+	return dTransVal[position.x][position.y] == dTransVal[next.x][next.y]
+	    && position.x / SectorSize == next.x / SectorSize
+	    && position.y / SectorSize == next.y / SectorSize;
+}
+
+/** @brief Assigns every tile that can ever be walked on to a room, returning the number of rooms. */
+uint16_t FindRooms()
+{
+	std::fill(&TileRooms[0][0], &TileRooms[0][0] + MAXDUNX * MAXDUNY, NoRoom);
+	uint16_t roomCount = 0;
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			if (TileRooms[x][y] != NoRoom || !IsTileEverWalkable({ x, y }))
+				continue;
+			const uint16_t room = ++roomCount;
+			TileRooms[x][y] = room;
+			SearchQueue.clear();
+			SearchQueue.push_back({ x, y });
+			for (size_t i = 0; i < SearchQueue.size(); i++) {
+				const Point position = SearchQueue[i];
+				for (const Displacement &direction : PathDirs) {
+					const Point next = position + direction;
+					if (!InDungeonBounds(next) || TileRooms[next.x][next.y] != NoRoom || !IsInSameRoom(position, next))
+						continue;
+					if (!IsTileEverWalkable(next) || !CanEverStep(position, next))
+						continue;
+					TileRooms[next.x][next.y] = room;
+					SearchQueue.push_back(next);
+				}
+			}
+		}
+	}
+	return roomCount;
+}
+
+/** @brief Breadth-first search from `root` over the tiles of its room, filling `RoomSteps`. */
+void SearchRoom(Point root)
+{
+	const uint16_t room = TileRooms[root.x][root.y];
+	SearchQueue.clear();
+	RoomSteps[root.x][root.y] = 0;
+	SearchQueue.push_back(root);
+	for (size_t i = 0; i < SearchQueue.size(); i++) {
+		const Point position = SearchQueue[i];
+		for (const Displacement &direction : PathDirs) {
+			const Point next = position + direction;
+			if (!InDungeonBounds(next) || TileRooms[next.x][next.y] != room || RoomSteps[next.x][next.y] != NotSearched)
+				continue;
+			if (!CanEverStep(position, next))
+				continue;
+			RoomSteps[next.x][next.y] = static_cast<uint16_t>(RoomSteps[position.x][position.y] + 1);
+			SearchQueue.push_back(next);
+		}
+	}
+}
+
+/** @brief Forgets the steps of the last room search. */
+void ClearRoomSearch()
+{
+	for (const Point position : SearchQueue)
+		RoomSteps[position.x][position.y] = NotSearched;
+}
+
+uint32_t GetPortal(Point position)
+{
+	const uint16_t room = TileRooms[position.x][position.y];
+	for (const uint32_t portal : RoomPortals[room]) {
+		if (Portals[portal].position == position)
+			return portal;
+	}
+	const auto portal = static_cast<uint32_t>(Portals.size());
+	Portals.push_back({ position, room });
+	PortalLinks.emplace_back();
+	RoomPortals[room].push_back(portal);
+	return portal;
+}
+
+/**
+ * @brief Joins each pair of neighbouring rooms by a portal on either side of their border.
+ *
+ * Of all the steps across the border, the one in the middle is taken, which keeps routes close to the shortest path.
+ */
+void FindPortals()
+{
+	struct BorderStep {
+		uint32_t rooms;
+		Point from;
+		Point to;
+	};
+	std::vector<BorderStep> borderSteps;
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			const uint16_t room = TileRooms[x][y];
+			if (room == NoRoom)
+				continue;
+			for (const Displacement &direction : PathDirs) {
+				const Point next = Point { x, y } + direction;
+				if (!InDungeonBounds(next))
+					continue;
+				const uint16_t nextRoom = TileRooms[next.x][next.y];
+				if (nextRoom == NoRoom || nextRoom <= room || !CanEverStep({ x, y }, next))
+					continue;
+				borderSteps.push_back({ static_cast<uint32_t>(room) << 16 | nextRoom, { x, y }, next });
+			}
+		}
+	}
+	std::stable_sort(borderSteps.begin(), borderSteps.end(), [](const BorderStep &a, const BorderStep &b) { return a.rooms < b.rooms; });
+
+	for (auto first = borderSteps.begin(); first != borderSteps.end();) {
+		const auto last = std::find_if(first, borderSteps.end(), [&](const BorderStep &step) { return step.rooms != first->rooms; });
+		const BorderStep &middle = first[(last - first) / 2];
+		const uint32_t from = GetPortal(middle.from);
+		const uint32_t to = GetPortal(middle.to);
+		PortalLinks[from].push_back({ to, 1 });
+		PortalLinks[to].push_back({ from, 1 });
+		first = last;
+	}
+}
+
+/** @brief Links the portals of each room to the other portals of the same room. */
+void LinkPortalsThroughRooms()
+{
+	for (const std::vector<uint32_t> &portals : RoomPortals) {
+		for (const uint32_t portal : portals) {
+			SearchRoom(Portals[portal].position);
+			for (const uint32_t other : portals) {
+				const Point position = Portals[other].position;
+				if (other != portal)
+					PortalLinks[portal].push_back({ other, RoomSteps[position.x][position.y] });
+			}
+			ClearRoomSearch();
+		}
+	}
+}
+
+void BuildRoomGraph()
+{
+	std::fill(&RoomSteps[0][0], &RoomSteps[0][0] + MAXDUNX * MAXDUNY, NotSearched);
+	SearchQueue.reserve(MAXDUNX * MAXDUNY);
+	Portals.clear();
+	PortalLinks.clear();
+	RoomPortals.clear();
+	RoomPortals.resize(FindRooms() + 1);
+	FindPortals();
+	LinkPortalsThroughRooms();
+	RoomGraphValid = true;
+}
+
+} // namespace
+
+bool FindRoomRoute(Point startPosition, Point destinationPosition, std::vector<RouteWaypoint> &route)
+{
+	route.clear();
+	if (!InDungeonBounds(startPosition) || !InDungeonBounds(destinationPosition))
+		return false;
+	if (!RoomGraphValid)
+		BuildRoomGraph();
+
+	const uint16_t startRoom = TileRooms[startPosition.x][startPosition.y];
+	const uint16_t destinationRoom = TileRooms[destinationPosition.x][destinationPosition.y];
+	if (startRoom == NoRoom || destinationRoom == NoRoom || startRoom == destinationRoom)
+		return false;
+
+	// Dijkstra's algorithm over the portals, with an extra node for the destination.
+	const auto destination = static_cast<uint32_t>(Portals.size());
+	std::vector<uint32_t> distances(Portals.size() + 1, Unreachable);
+	std::vector<uint32_t> previous(Portals.size() + 1, NoPortal);
+	using QueueEntry = std::pair<uint32_t, uint32_t>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+	SearchRoom(startPosition);
+	for (const uint32_t portal : RoomPortals[startRoom]) {
+		const Point position = Portals[portal].position;
+		distances[portal] = RoomSteps[position.x][position.y];
+		queue.emplace(distances[portal], portal);
+	}
+	ClearRoomSearch();
+
+	std::vector<PortalLink> exits;
+	SearchRoom(destinationPosition);
+	for (const uint32_t portal : RoomPortals[destinationRoom]) {
+		const Point position = Portals[portal].position;
+		exits.push_back({ portal, RoomSteps[position.x][position.y] });
+	}
+	ClearRoomSearch();
+
+	const auto relax = [&](uint32_t from, uint32_t to, uint32_t steps) {
+		if (distances[from] + steps >= distances[to])
+			return;
+		distances[to] = distances[from] + steps;
+		previous[to] = from;
+		queue.emplace(distances[to], to);
+	};
+	while (!queue.empty()) {
+		const auto [distance, portal] = queue.top();
+		queue.pop();
+		if (portal == destination)
+			break;
+		if (distance != distances[portal])
+			continue;
+		for (const PortalLink &link : PortalLinks[portal])
+			relax(portal, link.portal, link.steps);
+		if (Portals[portal].room == destinationRoom) {
+			for (const PortalLink &exit : exits) {
+				if (exit.portal == portal)
+					relax(portal, destination, exit.steps);
+			}
+		}
+	}
+	if (distances[destination] == Unreachable)
+		return false;
+
+	route.push_back({ destinationPosition, distances[destination] });
+	for (uint32_t portal = previous[destination]; portal != NoPortal; portal = previous[portal])
+		route.push_back({ Portals[portal].position, distances[portal] });
+	std::reverse(route.begin(), route.end());
+	return true;
+}
+
+void InvalidateRoomGraph()
+{
+	RoomGraphValid = false;
+}
+
+} // namespace devilution
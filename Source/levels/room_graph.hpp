@@ -0,0 +1,40 @@
+/**
+ * @file levels/room_graph.hpp
+ *
+ * Graph of the rooms of the current level and the tiles joining them, for finding routes longer than a path.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/point.hpp"
+
+namespace devilution {
+
+/** @brief A tile a route goes through, with the number of steps to it from the start of the route. */
+struct RouteWaypoint {
+	Point position;
+	uint32_t steps;
+};
+
+/**
+ * @brief Finds a route from `startPosition` to `destinationPosition` across the rooms of the level.
+ *
+ * The level is split into rooms: connected tiles of the same `dTransVal` room that also lie in the same 16x16 sector,
+ * so no room is larger than a path can cross. A route leads from room to room through the tiles on their borders, each
+ * waypoint after the first being at most a room away from the previous one, so `FindPath` can join consecutive
+ * waypoints, and the last waypoint is the destination.
+ *
+ * Only the layout of the level is taken into account: doors count as open, and monsters, players and other objects as
+ * absent. The rooms are built when first needed and reused until the layout of the level changes.
+ *
+ * @param route Receives the waypoints, excluding the start position.
+ * @return Whether there is a route. There is none when both positions are in the same room, as `FindPath` does better.
+ */
+bool FindRoomRoute(Point startPosition, Point destinationPosition, std::vector<RouteWaypoint> &route);
+
+/** @brief Rebuilds the rooms when next needed. Called whenever a level is loaded or its layout changes. */
+void InvalidateRoomGraph();
+
+} // namespace devilution
@@ -85,4 +85,20 @@ bool CanStep(Point startPosition, Point destinationPosition)
 	return rv;
 }
 
+bool IsTileEverWalkable(Point position)
+{
+	const Object *object = FindObjectAtPosition(position);
+	if (object != nullptr && object->isDoor())
+		return true;
+	return IsTileNotSolid(position);
+}
+
+bool CanEverStep(Point startPosition, Point destinationPosition)
+{
+	if (startPosition.x == destinationPosition.x || startPosition.y == destinationPosition.y)
+		return true;
+	return IsTileEverWalkable({ startPosition.x, destinationPosition.y })
+	    && IsTileEverWalkable({ destinationPosition.x, startPosition.y });
+}
+
 } // namespace devilution
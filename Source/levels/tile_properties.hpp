@@ -29,4 +29,14 @@ namespace devilution {
  */
 [[nodiscard]] bool CanStep(Point startPosition, Point destinationPosition);
 
+/**
+ * @brief Whether the tile can ever be walked on while the level layout stays the same.
+ *
+ * This is more permissive than any `posOk` passed to `FindPath`: doors count as open.
+ */
+[[nodiscard]] bool IsTileEverWalkable(Point position);
+
+/** @brief Like `CanStep`, but doors never block a diagonal step. */
+[[nodiscard]] bool CanEverStep(Point startPosition, Point destinationPosition);
+
 } // namespace devilution
@@ -8,6 +8,7 @@
 #include "game_mode.hpp"
 #include "levels/drlg_l1.h"
 #include "levels/trigs.h"
+#include "levels/walkability.hpp"
 #include "multi.h"
 #include "player.h"
 #include "quests.h"
@@ -329,6 +330,7 @@ void TownOpenHive()
 	dPiece[85][64] = 15;
 	dPiece[86][60] = 16;
 	dPiece[86][61] = 17;
+	InvalidateLevelLayout();
 }
 
 void TownOpenGrave()
@@ -346,6 +348,7 @@ void TownOpenGrave()
 	dPiece[37][24] = 0x539;
 	dPiece[35][21] = 0x53a;
 	dPiece[34][21] = 0x53b;
+	InvalidateLevelLayout();
 }
 
 void CleanTownFountain()
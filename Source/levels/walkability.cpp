@@ -0,0 +1,71 @@
+#include "levels/walkability.hpp"
+
+#include "engine/point.hpp"
+#include "levels/distance_field.hpp"
+#include "levels/gendung.h"
+#include "levels/room_graph.hpp"
+
+namespace devilution {
+
+namespace {
+
+Walkability CurrentWalkability;
+bool SolidTilesValid = false;
+bool OccupiedTilesValid = false;
+
+void RebuildSolidTiles()
+{
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			CurrentWalkability.solid.set(x, y, TileHasAny({ x, y }, TileProperties::Solid));
+		}
+	}
+	SolidTilesValid = true;
+}
+
+void RebuildOccupiedTiles()
+{
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++) {
+			CurrentWalkability.occupied.set(x, y, dPlayer[x][y] != 0 || dMonster[x][y] != 0 || dObject[x][y] != 0);
+		}
+	}
+	OccupiedTilesValid = true;
+}
+
+} // namespace
+
+const Walkability &GetWalkability()
+{
+	if (!SolidTilesValid)
+		RebuildSolidTiles();
+	if (!OccupiedTilesValid)
+		RebuildOccupiedTiles();
+	return CurrentWalkability;
+}
+
+void MarkTileOccupied(Point position)
+{
+	if (OccupiedTilesValid)
+		CurrentWalkability.occupied.set(position.x, position.y);
+}
+
+void InvalidateOccupiedTiles()
+{
+	OccupiedTilesValid = false;
+}
+
+void InvalidateWalkability()
+{
+	SolidTilesValid = false;
+	OccupiedTilesValid = false;
+}
+
+void InvalidateLevelLayout()
+{
+	InvalidateWalkability();
+	InvalidateRoomGraph();
+	InvalidateDistanceFields();
+}
+
+} // namespace devilution
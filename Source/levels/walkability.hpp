@@ -0,0 +1,82 @@
+/**
+ * @file levels/walkability.hpp
+ *
+ * Packed bitboards of the current level, which let path searches skip most lookups of tiles and their occupants.
+ */
+#pragma once
+
+#include "engine/point.hpp"
+#include "levels/gendung_defs.hpp"
+#include "utils/bitset2d.hpp"
+
+namespace devilution {
+
+/**
+ * @brief One bit per dungeon tile for what the `canStep` and `posOk` checks of `FindPath` look up.
+ *
+ * The checks on these bits give the same answers as `CanStep`, `IsTileNotSolid` and, for vacant tiles,
+ * `IsTileWalkable`, without reading `dPiece`, `SOLData`, `dObject`, `dMonster` or `dPlayer`.
+ */
+struct Walkability {
+	/** Tiles with a solid dungeon piece. */
+	Bitset2d<MAXDUNX, MAXDUNY> solid;
+
+	/**
+	 * Tiles that may have a player, a monster or an object on them.
+	 *
+	 * A tile is marked as soon as anything moves onto it, but only cleared when the bitboard is rebuilt on the next game
+	 * tick, so a marked tile may have been vacated since.
+	 */
+	Bitset2d<MAXDUNX, MAXDUNY> occupied;
+
+	[[nodiscard]] static bool isInBounds(Point position)
+	{
+		return static_cast<unsigned>(position.x) < MAXDUNX && static_cast<unsigned>(position.y) < MAXDUNY;
+	}
+
+	/** @brief Same as `IsTileNotSolid`. */
+	[[nodiscard]] bool isTileNotSolid(Point position) const
+	{
+		return isInBounds(position) && !solid.test(position.x, position.y);
+	}
+
+	/** @brief Same as `CanStep`. */
+	[[nodiscard]] bool canStep(Point startPosition, Point destinationPosition) const
+	{
+		if (startPosition.x == destinationPosition.x || startPosition.y == destinationPosition.y)
+			return true;
+		return isTileNotSolid({ startPosition.x, destinationPosition.y }) && isTileNotSolid({ destinationPosition.x, startPosition.y });
+	}
+
+	/**
+	 * @brief Whether the tile is in the dungeon and has no player, monster or object on it.
+	 *
+	 * On a vacant tile, `PosOkPlayer` and `IsTileWalkable` only depend on `isTileNotSolid`.
+	 * A tile that is not vacant may still be free, so callers fall back to the full check for it.
+	 */
+	[[nodiscard]] bool isTileVacant(Point position) const
+	{
+		return isInBounds(position) && !occupied.test(position.x, position.y);
+	}
+};
+
+/** @brief Returns the bitboards of the current level, first rebuilding the ones that were invalidated. */
+const Walkability &GetWalkability();
+
+/** @brief Marks the tile a player, monster or object was placed on as occupied. */
+void MarkTileOccupied(Point position);
+
+/** @brief Rebuilds the occupied tiles when next needed, forgetting the vacated ones. Called on every game tick. */
+void InvalidateOccupiedTiles();
+
+/** @brief Rebuilds all bitboards when next needed. */
+void InvalidateWalkability();
+
+/**
+ * @brief Discards the bitboards, the room graph and the walking distances of the level.
+ *
+ * Must be called whenever a level is loaded or `dPiece` changes while it is played, such as when a door opens.
+ */
+void InvalidateLevelLayout();
+
+} // namespace devilution
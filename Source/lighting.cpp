@@ -19,12 +19,15 @@
 #include "engine/load_file.hpp"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
+#include "engine/profiler.hpp"
+#include "engine/rectangle.hpp"
 #include "engine/world_tile.hpp"
 #include "levels/tile_properties.hpp"
 #include "objects.h"
 #include "player.h"
 #include "utils/attributes.h"
 #include "utils/is_of.hpp"
+#include "utils/static_vector.hpp"
 #include "utils/status_macros.hpp"
 #include "vision.hpp"
 
@@ -53,9 +56,25 @@ constexpr size_t NumLightRadiuses = 16;
 /** Falloff tables for the light cone */
 uint8_t LightFalloffs[NumLightRadiuses][128];
 bool UpdateVision;
+/** @brief Set when a light was added, removed or changed since the last call to ProcessLightList. */
+bool LightsChanged;
+/** @brief Lights that have to be drawn even if no neighbouring light changed, e.g. because they were just added. */
+std::array<bool, MAXLIGHTS> LightNeedsUpdate;
 /** interpolations of a 32x32 (16x16 mirrored) light circle moving between tiles in steps of 1/8 of a tile */
 uint8_t LightConeInterpolations[8][8][16][16];
 
+struct LightConeTile {
+	DisplacementOf<int8_t> displacement;
+	uint8_t distance;
+};
+
+/** Maximum number of tiles around the center of a light cone, 14x15 tiles per quadrant */
+constexpr size_t MaxLightConeTiles = 4 * 14 * 15;
+/** The tiles of each light cone interpolation sorted by distance, so the tiles reached by a radius are a prefix of the list */
+LightConeTile LightConeTiles[8][8][MaxLightConeTiles];
+/** Number of tiles in LightConeTiles that are within reach of each light radius */
+uint16_t LightConeTileCounts[8][8][NumLightRadiuses];
+
 void RotateRadius(DisplacementOf<int8_t> &offset, DisplacementOf<int8_t> &dist, DisplacementOf<int8_t> &light, DisplacementOf<int8_t> &block)
 {
 	dist = { static_cast<int8_t>(7 - dist.deltaY), dist.deltaX };
@@ -90,6 +109,42 @@ DVL_ALWAYS_INLINE uint8_t GetLight(Point position)
 	return dLight[position.x][position.y];
 }
 
+/**
+ * @brief Flattens the light cone walk of DoLighting for one sub-tile offset.
+ *
+ * Must be kept in sync with the loop in DoLighting, which is still used for lights close to the edge of the map.
+ */
+void BuildLightConeTiles(DisplacementOf<int8_t> offset)
+{
+	LightConeTile *tiles = LightConeTiles[offset.deltaX][offset.deltaY];
+	size_t count = 0;
+
+	DisplacementOf<int8_t> light = {};
+	DisplacementOf<int8_t> block = {};
+	DisplacementOf<int8_t> dist = offset;
+	DisplacementOf<int8_t> rotatedOffset = offset;
+	for (int i = 0; i < 4; i++) {
+		for (int y = 0; y < 15; y++) {
+			for (int x = 1; x < 15; x++) {
+				const uint8_t linearDistance = LightConeInterpolations[rotatedOffset.deltaX][rotatedOffset.deltaY][x + block.deltaX][y + block.deltaY];
+				if (linearDistance >= 128)
+					continue;
+				tiles[count++] = { DisplacementOf<int8_t>((Displacement { x, y }).Rotate(-i)), linearDistance };
+			}
+		}
+		RotateRadius(rotatedOffset, dist, light, block);
+	}
+
+	std::sort(tiles, tiles + count, [](const LightConeTile &a, const LightConeTile &b) { return a.distance < b.distance; });
+
+	// Tiles further away than the falloff of a radius are always fully dark and can't change the light map
+	for (unsigned radius = 0; radius < NumLightRadiuses; radius++) {
+		const unsigned maxDistance = (radius + 1) * 8;
+		const LightConeTile *end = std::upper_bound(tiles, tiles + count, maxDistance, [](unsigned distance, const LightConeTile &tile) { return distance < tile.distance; });
+		LightConeTileCounts[offset.deltaX][offset.deltaY][radius] = static_cast<uint16_t>(end - tiles);
+	}
+}
+
 bool TileAllowsLight(Point position)
 {
 	if (!InDungeonBounds(position))
@@ -109,6 +164,98 @@ void DoVisionFlags(Point position, MapExplorationType doAutomap, bool visible)
 	dFlags[position.x][position.y] |= DungeonFlag::Visible;
 }
 
+/**
+ * @brief Returns the tiles a light can affect.
+ *
+ * This matches the area restored by DoUnLight.
+ */
+Rectangle GetLightArea(Point position, uint8_t radius)
+{
+	return Rectangle { position, radius + 2 };
+}
+
+bool AreasOverlap(const Rectangle &a, const Rectangle &b)
+{
+	return a.position.x < b.position.x + b.size.width
+	    && b.position.x < a.position.x + a.size.width
+	    && a.position.y < b.position.y + b.size.height
+	    && b.position.y < a.position.y + a.size.height;
+}
+
+void RemoveLight(int i)
+{
+	ActiveLightCount--;
+	std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
+}
+
+void RelightAll()
+{
+	for (int i = 0; i < ActiveLightCount; i++) {
+		Light &light = Lights[ActiveLights[i]];
+		if (light.isInvalid) {
+			DoUnLight(light.position.tile, light.radius);
+		}
+		if (light.hasChanged) {
+			DoUnLight(light.position.old, light.oldRadius);
+			light.hasChanged = false;
+		}
+	}
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const Light &light = Lights[ActiveLights[i]];
+		LightNeedsUpdate[ActiveLights[i]] = false;
+		if (light.isInvalid) {
+			RemoveLight(i);
+			i--;
+			continue;
+		}
+		if (TileHasAny(light.position.tile, TileProperties::Solid))
+			continue; // Monster hidden in a wall, don't spoil the surprise
+		DoLighting(light.position.tile, light.radius, light.position.offset);
+	}
+}
+
+/**
+ * @brief Only restores the areas of lights that were removed or changed and then redraws the lights touching those areas.
+ *
+ * Lights are combined by taking the darkest value of each tile, so redrawing a subset of the lights over the restored areas
+ * gives the same result as RelightAll.
+ */
+void RelightChangedAreas()
+{
+	StaticVector<Rectangle, MAXLIGHTS * 2> dirtyAreas;
+	for (int i = 0; i < ActiveLightCount; i++) {
+		Light &light = Lights[ActiveLights[i]];
+		if (light.isInvalid) {
+			DoUnLight(light.position.tile, light.radius);
+			dirtyAreas.emplace_back(GetLightArea(light.position.tile, light.radius));
+		}
+		if (light.hasChanged) {
+			DoUnLight(light.position.old, light.oldRadius);
+			dirtyAreas.emplace_back(GetLightArea(light.position.old, light.oldRadius));
+			light.hasChanged = false;
+			LightNeedsUpdate[ActiveLights[i]] = true;
+		}
+	}
+	for (int i = 0; i < ActiveLightCount; i++) {
+		const Light &light = Lights[ActiveLights[i]];
+		const bool needsUpdate = LightNeedsUpdate[ActiveLights[i]];
+		LightNeedsUpdate[ActiveLights[i]] = false;
+		if (light.isInvalid) {
+			RemoveLight(i);
+			i--;
+			continue;
+		}
+		if (!needsUpdate) {
+			const Rectangle lightArea = GetLightArea(light.position.tile, light.radius);
+			if (std::none_of(dirtyAreas.begin(), dirtyAreas.end(), [&](const Rectangle &area) { return AreasOverlap(area, lightArea); }))
+				continue;
+		}
+		if (TileHasAny(light.position.tile, TileProperties::Solid))
+			continue; // Monster hidden in a wall, don't spoil the surprise
+		DoLighting(light.position.tile, light.radius, light.position.offset);
+	}
+}
+
 } // namespace
 
 void DoUnLight(Point position, uint8_t radius)
@@ -168,6 +315,19 @@ void DoLighting(Point position, uint8_t radius, DisplacementOf<int8_t> offset)
 		SetLight(position, 0);
 	}
 
+	if (minX == 15 && maxX == 15 && minY == 15 && maxY == 15) {
+		// The whole cone is inside the map, so we can use the precomputed tiles
+		const LightConeTile *tiles = LightConeTiles[offset.deltaX][offset.deltaY];
+		const uint16_t count = LightConeTileCounts[offset.deltaX][offset.deltaY][radius];
+		for (uint16_t i = 0; i < count; i++) {
+			const Point temp = position + tiles[i].displacement;
+			const uint8_t v = LightFalloffs[radius][tiles[i].distance];
+			if (v < GetLight(temp))
+				SetLight(temp, v);
+		}
+		return;
+	}
+
 	for (int i = 0; i < 4; i++) {
 		const int yBound = i > 0 && i < 3 ? maxY : minY;
 		const int xBound = i < 2 ? maxX : minX;
@@ -325,6 +485,12 @@ void MakeLightTable()
 			}
 		}
 	}
+
+	for (int8_t offsetY = 0; offsetY < 8; offsetY++) {
+		for (int8_t offsetX = 0; offsetX < 8; offsetX++) {
+			BuildLightConeTiles({ offsetX, offsetY });
+		}
+	}
 }
 
 #ifdef _DEBUG
@@ -350,6 +516,8 @@ void InitLighting()
 {
 	ActiveLightCount = 0;
 	UpdateLighting = false;
+	LightsChanged = false;
+	LightNeedsUpdate = {};
 	UpdateVision = false;
 #ifdef _DEBUG
 	DisableLighting = false;
@@ -377,7 +545,8 @@ int AddLight(Point position, uint8_t radius)
 	light.isInvalid = false;
 	light.hasChanged = false;
 
-	UpdateLighting = true;
+	LightNeedsUpdate[lid] = true;
+	LightsChanged = true;
 
 	return lid;
 }
@@ -393,7 +562,7 @@ void AddUnLight(int i)
 
 	Lights[i].isInvalid = true;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightRadius(int i, uint8_t radius)
@@ -411,7 +580,7 @@ void ChangeLightRadius(int i, uint8_t radius)
 	light.oldRadius = light.radius;
 	light.radius = radius;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightXY(int i, Point position)
@@ -429,7 +598,7 @@ void ChangeLightXY(int i, Point position)
 	light.oldRadius = light.radius;
 	light.position.tile = position;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLightOffset(int i, DisplacementOf<int8_t> offset)
@@ -450,7 +619,7 @@ void ChangeLightOffset(int i, DisplacementOf<int8_t> offset)
 	light.oldRadius = light.radius;
 	light.position.offset = offset;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
 void ChangeLight(int i, Point position, uint8_t radius)
@@ -469,41 +638,43 @@ void ChangeLight(int i, Point position, uint8_t radius)
 	light.position.tile = position;
 	light.radius = radius;
 
-	UpdateLighting = true;
+	LightsChanged = true;
 }
 
-void ProcessLightList()
+void ChangeLightsAt(Point position)
 {
 #ifdef _DEBUG
 	if (DisableLighting)
 		return;
 #endif
-	if (!UpdateLighting)
-		return;
 	for (int i = 0; i < ActiveLightCount; i++) {
 		Light &light = Lights[ActiveLights[i]];
-		if (light.isInvalid) {
-			DoUnLight(light.position.tile, light.radius);
-		}
-		if (light.hasChanged) {
-			DoUnLight(light.position.old, light.oldRadius);
-			light.hasChanged = false;
-		}
-	}
-	for (int i = 0; i < ActiveLightCount; i++) {
-		const Light &light = Lights[ActiveLights[i]];
-		if (light.isInvalid) {
-			ActiveLightCount--;
-			std::swap(ActiveLights[ActiveLightCount], ActiveLights[i]);
-			i--;
+		if (light.isInvalid || !GetLightArea(light.position.tile, light.radius).contains(position))
 			continue;
+		// Unlighting the light's current area lets the tile darken again when it starts blocking light.
+		if (!light.hasChanged) {
+			light.hasChanged = true;
+			light.position.old = light.position.tile;
+			light.oldRadius = light.radius;
 		}
-		if (TileHasAny(light.position.tile, TileProperties::Solid))
-			continue; // Monster hidden in a wall, don't spoil the surprise
-		DoLighting(light.position.tile, light.radius, light.position.offset);
+		LightsChanged = true;
 	}
+}
+
+void ProcessLightList()
+{
+	DVL_PROFILE_ZONE(ProcessLightList);
+#ifdef _DEBUG
+	if (DisableLighting)
+		return;
+#endif
+	if (UpdateLighting)
+		RelightAll();
+	else if (LightsChanged)
+		RelightChangedAreas();
 
 	UpdateLighting = false;
+	LightsChanged = false;
 }
 
 void SavePreLighting()
@@ -545,6 +716,7 @@ void ChangeVisionXY(size_t id, Point position)
 
 void ProcessVisionList()
 {
+	DVL_PROFILE_ZONE(ProcessVisionList);
 	if (!UpdateVision)
 		return;
 
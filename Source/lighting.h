@@ -51,6 +51,7 @@ extern std::array<uint8_t, 256> PauseTable;
 #ifdef _DEBUG
 extern bool DisableLighting;
 #endif
+/** @brief Forces the next ProcessLightList to redraw every light, needed after dLight has been reset. */
 extern bool UpdateLighting;
 
 void DoUnLight(Point position, uint8_t radius);
@@ -69,6 +70,8 @@ void ChangeLightRadius(int i, uint8_t radius);
 void ChangeLightXY(int i, Point position);
 void ChangeLightOffset(int i, DisplacementOf<int8_t> offset);
 void ChangeLight(int i, Point position, uint8_t radius);
+/** @brief Redraws the lights that reach `position` on the next ProcessLightList, after the tile changed whether it blocks light. */
+void ChangeLightsAt(Point position);
 void ProcessLightList();
 void SavePreLighting();
 void ActivateVision(Point position, int r, size_t id);
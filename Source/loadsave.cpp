@@ -28,6 +28,7 @@
 #include "game_mode.hpp"
 #include "inv.h"
 #include "levels/dun_tile.hpp"
+#include "levels/walkability.hpp"
 #include "lighting.h"
 #include "menu.h"
 #include "missiles.h"
@@ -804,6 +805,7 @@ void LoadMonsters(LoadHelper &file, ankerl::unordered_dense::set<unsigned> &remo
 
 		i++;
 	}
+	RebuildMonsterSpatialIndex();
 
 	for (const unsigned removedMonsterId : removedMonsterIds) {
 		for (size_t i = 0; i < ActiveMonsterCount; i++) {
@@ -1868,7 +1870,7 @@ void SaveAdditionalMissiles(SaveWriter &saveWriter)
 
 	if (missileCountAdditional > 0) {
 		auto it = Missiles.cbegin();
-		// std::list::const_iterator doesn't provide operator+() :/ using std::advance to get past the missiles we've already saved
+		// Missiles only provides forward iterators, using std::advance to get past the missiles we've already saved
 		std::advance(it, MaxMissilesForSaveGame);
 		for (; it != Missiles.cend(); it++) {
 			SaveMissile(&file, *it);
@@ -2084,6 +2086,7 @@ tl::expected<void, std::string> LoadLevel(LevelConversionData *levelConversionDa
 
 		// No need to load dLight, we can recreate it accurately from LightList
 		memcpy(dLight, dPreLight, sizeof(dLight));                                     // resets the light on entering a level to get rid of incorrect light
+		UpdateLighting = true;
 		ChangeLightXY(Players[MyPlayerId].lightId, Players[MyPlayerId].position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
@@ -2641,10 +2644,12 @@ tl::expected<void, std::string> LoadGame(bool firstflag)
 
 		// No need to load dLight, we can recreate it accurately from LightList
 		memcpy(dLight, dPreLight, sizeof(dLight));               // resets the light on entering a level to get rid of incorrect light
+		UpdateLighting = true;
 		ChangeLightXY(myPlayer.lightId, myPlayer.position.tile); // forces player light refresh
 	} else {
 		memset(dLight, 0, sizeof(dLight));
 	}
+	InvalidateLevelLayout();
 
 	PremiumItemCount = file.NextBE<int32_t>();
 	PremiumItemLevel = file.NextBE<int32_t>();
@@ -13,7 +13,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <list>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -33,6 +32,7 @@
 #include "engine/lighting_defs.hpp"
 #include "engine/path.h"
 #include "engine/point.hpp"
+#include "engine/profiler.hpp"
 #include "engine/render/scrollrt.h"
 #include "engine/world_tile.hpp"
 #include "function_ref.hpp"
@@ -70,7 +70,7 @@
 
 namespace devilution {
 
-std::list<Missile> Missiles;
+SlotPool<Missile, MissileBlockSize> Missiles;
 bool MissilePreFlag;
 
 void Missile::setAnimation(MissileGraphicID animtype)
@@ -3718,6 +3718,7 @@ void ProcessRhino(Missile &missile)
 	monster.position.future = newPos;
 	monster.position.old = newPos;
 	monster.position.tile = newPos;
+	UpdateMonsterSpatialIndex(monster);
 	monster.occupyTile(newPos, true);
 	if (monster.isUnique())
 		ChangeLightXY(missile._mlid, newPos);
@@ -4180,6 +4181,7 @@ void ProcessManaShield()
 
 void ProcessMissiles()
 {
+	DVL_PROFILE_ZONE(ProcessMissiles);
 	for (auto &missile : Missiles) {
 		const auto &position = missile.position.tile;
 		if (InDungeonBounds(position)) {
@@ -5,8 +5,8 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <list>
 #include <optional>
 
 #include "engine/displacement.hpp"
@@ -16,7 +16,9 @@
 #include "monster.h"
 #include "player.h"
 #include "spelldat.h"
+#include "utils/attributes.h"
 #include "utils/is_of.hpp"
+#include "utils/slot_pool.hpp"
 
 namespace devilution {
 
@@ -235,7 +237,10 @@ public:
 	}
 };
 
-extern std::list<Missile> Missiles;
+/** Missiles are allocated in blocks of this many, enough for a typical level without growing. */
+constexpr size_t MissileBlockSize = 128;
+
+extern DVL_API_FOR_TEST SlotPool<Missile, MissileBlockSize> Missiles;
 extern bool MissilePreFlag;
 
 struct DamageRange {
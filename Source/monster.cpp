@@ -36,16 +36,18 @@
 #include "diablo.h"
 #include "effects.h"
 #include "engine/animationinfo.h"
+#include "engine/asset_prefetch.hpp"
 #include "engine/clx_sprite.hpp"
 #include "engine/direction.hpp"
 #include "engine/lighting_defs.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
 #include "engine/path.h"
+#include "engine/path_impl.hpp"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
+#include "engine/profiler.hpp"
 #include "engine/random.hpp"
-#include "engine/render/clx_render.hpp"
 #include "engine/sound.h"
 #include "engine/sound_position.hpp"
 #include "engine/world_tile.hpp"
@@ -56,6 +58,7 @@
 #include "itemdat.h"
 #include "items.h"
 #include "levels/crypt.h"
+#include "levels/distance_field.hpp"
 #include "levels/drlg_l4.h"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung.h"
@@ -63,6 +66,7 @@
 #include "levels/themes.h"
 #include "levels/tile_properties.hpp"
 #include "levels/trigs.h"
+#include "levels/walkability.hpp"
 #include "lighting.h"
 #include "minitext.h"
 #include "misdat.h"
@@ -126,6 +130,119 @@ size_t totalmonsters;
 int monstimgtot;
 int uniquetrans;
 
+/** Size in tiles of the square buckets of the monster spatial index. */
+constexpr int MonsterBucketSize = 8;
+constexpr int MonsterBucketsX = (MAXDUNX + MonsterBucketSize - 1) / MonsterBucketSize;
+constexpr int MonsterBucketsY = (MAXDUNY + MonsterBucketSize - 1) / MonsterBucketSize;
+
+/**
+ * @brief Grid-bucketed index of the monsters on the level by the tile they are on.
+ *
+ * Each bucket is a doubly linked list of monster ids, so moving a monster between buckets is O(1).
+ */
+class MonsterSpatialIndex {
+public:
+	MonsterSpatialIndex()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		heads_.fill(NoMonster);
+		bucketOf_.fill(NoMonster);
+	}
+
+	void update(size_t monsterId, Point tile)
+	{
+		const int16_t bucket = InDungeonBounds(tile) ? GetBucket(tile.x / MonsterBucketSize, tile.y / MonsterBucketSize) : NoMonster;
+		if (bucket == bucketOf_[monsterId])
+			return;
+		remove(monsterId);
+		if (bucket == NoMonster)
+			return;
+		const auto id = static_cast<int16_t>(monsterId);
+		next_[monsterId] = heads_[bucket];
+		prev_[monsterId] = NoMonster;
+		if (heads_[bucket] != NoMonster)
+			prev_[heads_[bucket]] = id;
+		heads_[bucket] = id;
+		bucketOf_[monsterId] = bucket;
+	}
+
+	void remove(size_t monsterId)
+	{
+		const int16_t bucket = bucketOf_[monsterId];
+		if (bucket == NoMonster)
+			return;
+		if (prev_[monsterId] != NoMonster)
+			next_[prev_[monsterId]] = next_[monsterId];
+		else
+			heads_[bucket] = next_[monsterId];
+		if (next_[monsterId] != NoMonster)
+			prev_[next_[monsterId]] = prev_[monsterId];
+		bucketOf_[monsterId] = NoMonster;
+	}
+
+	/**
+	 * @brief Visits the monsters within the given walking distance of a tile, bucket ring by bucket ring, nearest ring first.
+	 *
+	 * Monsters further away than @p maxDistance may be visited as well.
+	 *
+	 * @param keepSearching Called with the smallest walking distance a monster in the next ring can have, stops the search when it returns false.
+	 * @param visit Called with the id of each monster.
+	 */
+	template <typename KeepSearching, typename Visitor>
+	void forEachNear(Point center, int maxDistance, KeepSearching &&keepSearching, Visitor &&visit) const
+	{
+		const int centerX = std::clamp(center.x / MonsterBucketSize, 0, MonsterBucketsX - 1);
+		const int centerY = std::clamp(center.y / MonsterBucketSize, 0, MonsterBucketsY - 1);
+		const int minX = std::clamp((center.x - maxDistance) / MonsterBucketSize, 0, MonsterBucketsX - 1);
+		const int maxX = std::clamp((center.x + maxDistance) / MonsterBucketSize, 0, MonsterBucketsX - 1);
+		const int minY = std::clamp((center.y - maxDistance) / MonsterBucketSize, 0, MonsterBucketsY - 1);
+		const int maxY = std::clamp((center.y + maxDistance) / MonsterBucketSize, 0, MonsterBucketsY - 1);
+		const int maxRing = std::max({ centerX - minX, maxX - centerX, centerY - minY, maxY - centerY });
+
+		for (int ring = 0; ring <= maxRing; ring++) {
+			if (!keepSearching(ring == 0 ? 0 : (ring - 1) * MonsterBucketSize + 1))
+				return;
+			for (int y = std::max(centerY - ring, minY); y <= std::min(centerY + ring, maxY); y++) {
+				if (std::abs(y - centerY) == ring) {
+					for (int x = std::max(centerX - ring, minX); x <= std::min(centerX + ring, maxX); x++)
+						visitBucket(x, y, visit);
+					continue;
+				}
+				if (centerX - ring >= minX)
+					visitBucket(centerX - ring, y, visit);
+				if (centerX + ring <= maxX)
+					visitBucket(centerX + ring, y, visit);
+			}
+		}
+	}
+
+private:
+	static constexpr int16_t NoMonster = -1;
+
+	static int16_t GetBucket(int x, int y)
+	{
+		return static_cast<int16_t>(y * MonsterBucketsX + x);
+	}
+
+	template <typename Visitor>
+	void visitBucket(int x, int y, Visitor &visit) const
+	{
+		for (int16_t monsterId = heads_[GetBucket(x, y)]; monsterId != NoMonster; monsterId = next_[monsterId])
+			visit(static_cast<unsigned>(monsterId));
+	}
+
+	std::array<int16_t, MonsterBucketsX * MonsterBucketsY> heads_;
+	std::array<int16_t, MaxMonsters> next_;
+	std::array<int16_t, MaxMonsters> prev_;
+	std::array<int16_t, MaxMonsters> bucketOf_;
+};
+
+MonsterSpatialIndex MonsterIndex;
+
 constexpr const std::array<_monster_id, 12> SkeletonTypes {
 	MT_WSKELAX,
 	MT_TSKELAX,
@@ -166,23 +283,9 @@ void InitMonsterTRN(CMonster &monst)
 {
 	char path[64];
 	*BufCopy(path, "monsters\\", monst.data().trnFile, ".trn") = '\0';
-	std::array<uint8_t, 256> colorTranslations;
-	LoadFileInMem(path, colorTranslations);
-	std::replace(colorTranslations.begin(), colorTranslations.end(), 255, 0);
-
-	const size_t numAnims = GetNumAnims(monst.data());
-	for (size_t i = 0; i < numAnims; i++) {
-		if (i == 1 && IsAnyOf(monst.type, MT_COUNSLR, MT_MAGISTR, MT_CABALIST, MT_ADVOCATE)) {
-			continue;
-		}
-
-		AnimStruct &anim = monst.anims[i];
-		if (anim.sprites->isSheet()) {
-			ClxApplyTrans(ClxSpriteSheet { anim.sprites->sheet() }, colorTranslations.data());
-		} else {
-			ClxApplyTrans(ClxSpriteList { anim.sprites->list() }, colorTranslations.data());
-		}
-	}
+	monst.trn = std::unique_ptr<uint8_t[]> { new uint8_t[256] };
+	LoadFileInMem(path, monst.trn.get(), 256);
+	std::replace(monst.trn.get(), monst.trn.get() + 256, 255, 0);
 }
 
 void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point position)
@@ -191,6 +294,7 @@ void InitMonster(Monster &monster, Direction rd, size_t typeIndex, Point positio
 	monster.position.tile = position;
 	monster.position.future = position;
 	monster.position.old = position;
+	UpdateMonsterSpatialIndex(monster);
 	monster.levelType = static_cast<uint8_t>(typeIndex);
 	monster.mode = MonsterMode::Stand;
 	monster.animInfo = {};
@@ -302,6 +406,7 @@ void PlaceGroup(size_t typeIndex, size_t num, Monster *leader = nullptr, bool le
 			placed--;
 			const Point &position = Monsters[ActiveMonsterCount].position.tile;
 			dMonster[position.x][position.y] = 0;
+			MonsterIndex.remove(ActiveMonsterCount);
 		}
 
 		int xp;
@@ -486,6 +591,7 @@ void ClrAllMonsters()
 		monster.enemyPosition = {};
 		DiscardRandomValues(1);
 	}
+	MonsterIndex.clear();
 }
 
 tl::expected<void, std::string> PlaceUniqueMonsters()
@@ -628,6 +734,7 @@ void DeleteMonster(size_t activeIndex)
 
 	ActiveMonsterCount--;
 	std::swap(ActiveMonsters[activeIndex], ActiveMonsters[ActiveMonsterCount]); // This ensures alive monsters are before ActiveMonsterCount in the array and any deleted monster after
+	MonsterIndex.remove(monsterId);
 
 	for (size_t i = 0; i < ActiveMonsterCount; i++) {
 		Monster &activeMonster = Monsters[ActiveMonsters[i]];
@@ -654,6 +761,7 @@ void StartMonsterGotHit(Monster &monster)
 	}
 	monster.position.tile = monster.position.old;
 	monster.position.future = monster.position.old;
+	UpdateMonsterSpatialIndex(monster);
 	M_ClearSquares(monster);
 	monster.occupyTile(monster.position.tile, false);
 }
@@ -663,12 +771,27 @@ DVL_ALWAYS_INLINE bool IsRanged(Monster &monster)
 	return IsAnyOf(monster.ai, MonsterAIID::SkeletonRanged, MonsterAIID::GoatRanged, MonsterAIID::Succubus, MonsterAIID::LazarusSuccubus);
 }
 
+/**
+ * @brief Returns whether a monster comes before another one in ActiveMonsters, which decides between equally good enemies.
+ */
+bool IsActiveBefore(unsigned monsterId, unsigned otherMonsterId)
+{
+	for (size_t i = 0; i < ActiveMonsterCount; i++) {
+		if (ActiveMonsters[i] == monsterId)
+			return true;
+		if (ActiveMonsters[i] == otherMonsterId)
+			return false;
+	}
+	return false;
+}
+
 void UpdateEnemy(Monster &monster)
 {
 	WorldTilePosition target;
 	int menemy = -1;
 	int bestDist = -1;
 	bool bestsameroom = false;
+	bool bestIsMonster = false;
 	const WorldTilePosition position = monster.position.tile;
 	const bool isPlayerMinion = monster.isPlayerMinion();
 	if (!isPlayerMinion) {
@@ -690,41 +813,46 @@ void UpdateEnemy(Monster &monster)
 			}
 		}
 	}
-	for (size_t i = 0; i < ActiveMonsterCount; i++) {
-		const unsigned monsterId = ActiveMonsters[i];
-		Monster &otherMonster = Monsters[monsterId];
-		if (&otherMonster == &monster)
-			continue;
-		if ((otherMonster.hitPoints >> 6) <= 0)
-			continue;
-		if (otherMonster.position.tile == GolemHoldingCell)
-			continue;
-		if (otherMonster.talkMsg != TEXT_NONE && M_Talker(otherMonster))
-			continue;
-		if (isPlayerMinion && otherMonster.isPlayerMinion()) // prevent golems from fighting each other
-			continue;
-
-		const int dist = otherMonster.position.tile.WalkingDistance(position);
-		if (((monster.flags & MFLAG_GOLEM) == 0
-		        && (monster.flags & MFLAG_BERSERK) == 0
-		        && dist >= 2
-		        && !IsRanged(monster))
-		    || ((monster.flags & MFLAG_GOLEM) == 0
-		        && (monster.flags & MFLAG_BERSERK) == 0
-		        && (otherMonster.flags & MFLAG_GOLEM) == 0)) {
-			continue;
-		}
-		const bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
-		if ((sameroom && !bestsameroom)
-		    || ((sameroom || !bestsameroom) && dist < bestDist)
-		    || (menemy == -1)) {
-			monster.flags |= MFLAG_TARGETS_MONSTER;
-			menemy = static_cast<int>(monsterId);
-			target = otherMonster.position.future;
-			bestDist = dist;
-			bestsameroom = sameroom;
-		}
-	}
+	// Only golems and berserk monsters attack any monster, others only attack golems that are adjacent or in range.
+	const bool attacksAnyMonster = (monster.flags & (MFLAG_GOLEM | MFLAG_BERSERK)) != 0;
+	const int maxDist = attacksAnyMonster || IsRanged(monster) ? std::max(MAXDUNX, MAXDUNY) : 1;
+	// The monsters are visited by distance rather than in ActiveMonsters order, so the enemy picked is the one that
+	// comes first in ActiveMonsters among the equally good ones, same as when scanning all active monsters in order.
+	MonsterIndex.forEachNear(
+	    position, maxDist,
+	    [&](int ringDist) {
+		    // No monster further away than an enemy in the same room can replace it
+		    return menemy == -1 || !bestsameroom || ringDist <= bestDist;
+	    },
+	    [&](unsigned monsterId) {
+		    Monster &otherMonster = Monsters[monsterId];
+		    if (&otherMonster == &monster)
+			    return;
+		    if ((otherMonster.hitPoints >> 6) <= 0)
+			    return;
+		    if (otherMonster.position.tile == GolemHoldingCell)
+			    return;
+		    if (otherMonster.talkMsg != TEXT_NONE && M_Talker(otherMonster))
+			    return;
+		    if (isPlayerMinion && otherMonster.isPlayerMinion()) // prevent golems from fighting each other
+			    return;
+
+		    const int dist = otherMonster.position.tile.WalkingDistance(position);
+		    if (!attacksAnyMonster && (dist > maxDist || (otherMonster.flags & MFLAG_GOLEM) == 0))
+			    return;
+		    const bool sameroom = dTransVal[position.x][position.y] == dTransVal[otherMonster.position.tile.x][otherMonster.position.tile.y];
+		    if ((sameroom && !bestsameroom)
+		        || ((sameroom || !bestsameroom) && dist < bestDist)
+		        || (sameroom == bestsameroom && dist == bestDist && bestIsMonster && IsActiveBefore(monsterId, static_cast<unsigned>(menemy)))
+		        || (menemy == -1)) {
+			    monster.flags |= MFLAG_TARGETS_MONSTER;
+			    menemy = static_cast<int>(monsterId);
+			    target = otherMonster.position.future;
+			    bestDist = dist;
+			    bestsameroom = sameroom;
+			    bestIsMonster = true;
+		    }
+	    });
 	if (menemy != -1) {
 		monster.flags &= ~MFLAG_NO_ENEMY;
 		monster.enemy = menemy;
@@ -879,6 +1007,7 @@ void DiabloDeath(Monster &diablo, bool sendmsg)
 		monster.var1 = 0;
 		monster.position.tile = monster.position.old;
 		monster.position.future = monster.position.tile;
+		UpdateMonsterSpatialIndex(monster);
 		M_ClearSquares(monster);
 		monster.occupyTile(monster.position.tile, false);
 	}
@@ -1078,6 +1207,7 @@ bool MonsterWalk(Monster &monster)
 		dMonster[monster.position.tile.x][monster.position.tile.y] = 0;
 		monster.position.tile.x += monster.var1;
 		monster.position.tile.y += monster.var2;
+		UpdateMonsterSpatialIndex(monster);
 		// dMonster is set here for backwards compatibility; without it, the monster would be invisible if loaded from a vanilla save.
 		monster.occupyTile(monster.position.tile, false);
 		ChangeLightXY(monster.lightId, monster.position.tile);
@@ -1739,7 +1869,24 @@ bool AiPlanWalk(Monster &monster)
 	/** Maps from walking path step to facing direction. */
 	const Direction plr2monst[9] = { Direction::South, Direction::NorthEast, Direction::NorthWest, Direction::SouthEast, Direction::SouthWest, Direction::North, Direction::East, Direction::South, Direction::West };
 
-	if (FindPath(CanStep, [&monster](Point position) { return IsTileAccessible(monster, position); }, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
+	// Many monsters chase the same player, who they can often not reach within the maximum path length,
+	// for example from the other side of a wall. The walking distances from the player rule these out quickly.
+	if ((monster.flags & (MFLAG_TARGETS_MONSTER | MFLAG_NO_ENEMY)) == 0) {
+		const Player &player = Players[monster.enemy];
+		if (monster.enemyPosition == player.position.future && GetWalkingDistanceLowerBound(player, monster.position.tile) > MaxPathLengthMonsters)
+			return false;
+	}
+
+	const Walkability &walkability = GetWalkability();
+	const auto canStep = [&walkability](Point startPosition, Point destinationPosition) {
+		return walkability.canStep(startPosition, destinationPosition);
+	};
+	const auto posOk = [&walkability, &monster](Point position) {
+		if (walkability.isTileVacant(position))
+			return walkability.isTileNotSolid(position) && IsTileSafe(monster, position);
+		return IsTileAccessible(monster, position);
+	};
+	if (FindPath(canStep, posOk, monster.position.tile, monster.enemyPosition, path, MaxPathLengthMonsters) == 0) {
 		return false;
 	}
 
@@ -3003,6 +3150,7 @@ void ActivateSpawn(Monster &monster, Point position, Direction dir)
 	monster.position.tile = position;
 	monster.position.future = position;
 	monster.position.old = position;
+	UpdateMonsterSpatialIndex(monster);
 	StartSpecialStand(monster, dir);
 }
 
@@ -3448,6 +3596,19 @@ tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType)
 	return {};
 }
 
+const uint8_t *CMonster::getTRN(ClxSpriteList sprites) const
+{
+	if (trn == nullptr)
+		return nullptr;
+	if (IsAnyOf(type, MT_COUNSLR, MT_MAGISTR, MT_CABALIST, MT_ADVOCATE)) {
+		// The walking animation of these has never been translated.
+		const AnimStruct &walk = getAnimData(MonsterGraphic::Walk);
+		if (walk.sprites && sprites.data() >= walk.sprites->data() && sprites.data() < walk.sprites->data() + walk.sprites->dataSize())
+			return nullptr;
+	}
+	return trn.get();
+}
+
 tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpritesData &&spritesData)
 {
 	if (HeadlessMode)
@@ -3475,6 +3636,8 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 
 	if (!monsterData.trnFile.empty()) {
 		InitMonsterTRN(monsterType);
+	} else {
+		monsterType.trn = nullptr;
 	}
 
 	if (IsAnyOf(mtype, MT_NMAGMA, MT_YMAGMA, MT_BMAGMA, MT_WMAGMA))
@@ -3522,6 +3685,29 @@ tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpr
 	return {};
 }
 
+void PrefetchMonsterGFX()
+{
+	if (HeadlessMode)
+		return;
+
+	std::vector<bool> isSpriteQueued(GetNumMonsterSprites());
+	std::vector<std::string> paths;
+	for (size_t i = 0; i < LevelMonsterTypeCount; ++i) {
+		const CMonster &monsterType = LevelMonsterTypes[i];
+		const MonsterData &monsterData = monsterType.data();
+		const auto spriteId = static_cast<size_t>(monsterData.spriteId);
+		if (monsterType.animData != nullptr || isSpriteQueued[spriteId])
+			continue;
+		isSpriteQueued[spriteId] = true;
+		const FileNameWithCharAffixGenerator pathFn({ "monsters\\", monsterData.spritePath() }, DEVILUTIONX_CL2_EXT, Animletter);
+		for (size_t j = 0; j < GetNumAnims(monsterData); ++j) {
+			if (monsterData.hasAnim(j))
+				paths.emplace_back(pathFn(j));
+		}
+	}
+	PrefetchAssets(paths);
+}
+
 tl::expected<void, std::string> InitAllMonsterGFX()
 {
 	if (HeadlessMode)
@@ -3543,16 +3729,14 @@ tl::expected<void, std::string> InitAllMonsterGFX()
 		MonsterSpritesData spritesData = LoadMonsterSpritesData(firstMonster.data());
 		const size_t spritesDataSize = spritesData.offsets[GetNumAnimsWithGraphics(firstMonster.data())];
 		for (size_t i = 1; i < monsterTypes.size(); ++i) {
-			MonsterSpritesData spritesDataCopy { std::unique_ptr<std::byte[]> { new std::byte[spritesDataSize] }, spritesData.offsets };
-			memcpy(spritesDataCopy.data.get(), spritesData.data.get(), spritesDataSize);
-			RETURN_IF_ERROR(InitMonsterGFX(LevelMonsterTypes[monsterTypes[i]], std::move(spritesDataCopy)));
+			RETURN_IF_ERROR(InitMonsterGFX(LevelMonsterTypes[monsterTypes[i]], MonsterSpritesData { spritesData }));
 		}
 		LogVerbose("Loaded monster graphics: {:15s} {:>4d} KiB   x{:d}", firstMonster.data().spritePath(), spritesDataSize / 1024, monsterTypes.size());
 		totalUniqueBytes += spritesDataSize;
 		totalBytes += spritesDataSize * monsterTypes.size();
 		RETURN_IF_ERROR(InitMonsterGFX(firstMonster, std::move(spritesData)));
 	}
-	LogVerbose(" Total monster graphics:                 {:>4d} KiB {:>4d} KiB", totalUniqueBytes / 1024, totalBytes / 1024);
+	LogVerbose(" Total monster graphics:                 {:>4d} KiB {:>4d} KiB ({:d} KiB saved by sharing)", totalUniqueBytes / 1024, totalBytes / 1024, (totalBytes - totalUniqueBytes) / 1024);
 
 	if (totalUniqueBytes > 0) {
 		// we loaded new sprites, check if we need to update existing monsters
@@ -3805,6 +3989,18 @@ void M_StartStand(Monster &monster, Direction md)
 	UpdateEnemy(monster);
 }
 
+void UpdateMonsterSpatialIndex(const Monster &monster)
+{
+	MonsterIndex.update(monster.getId(), monster.position.tile);
+}
+
+void RebuildMonsterSpatialIndex()
+{
+	MonsterIndex.clear();
+	for (size_t i = 0; i < ActiveMonsterCount; i++)
+		UpdateMonsterSpatialIndex(Monsters[ActiveMonsters[i]]);
+}
+
 void M_ClearSquares(const Monster &monster)
 {
 	for (const Point searchTile : PointsInRectangle(Rectangle { monster.position.old, 1 })) {
@@ -3888,6 +4084,7 @@ void MonsterDeath(Monster &monster, Direction md, bool sendmsg)
 	monster.var1 = 0;
 	monster.position.tile = monster.position.old;
 	monster.position.future = monster.position.old;
+	UpdateMonsterSpatialIndex(monster);
 	M_ClearSquares(monster);
 	monster.occupyTile(monster.position.tile, false);
 	CheckQuestKill(monster, sendmsg);
@@ -3925,6 +4122,7 @@ void M_SyncStartKill(Monster &monster, Point position, const Player &player)
 		M_ClearSquares(monster);
 		monster.position.tile = position;
 		monster.position.old = position;
+		UpdateMonsterSpatialIndex(monster);
 	}
 
 	StartMonsterDeath(monster, player, false);
@@ -4093,6 +4291,7 @@ void DeleteMonsterList()
 		golem.position.future = { 0, 0 };
 		golem.position.old = { 0, 0 };
 		golem.isInvalid = false;
+		UpdateMonsterSpatialIndex(golem);
 	}
 
 	for (size_t i = ReservedMonsterSlotsForGolems; i < ActiveMonsterCount;) {
@@ -4122,6 +4321,7 @@ void RemoveEnemyReferences(const Player &player)
 
 void ProcessMonsters()
 {
+	DVL_PROFILE_ZONE(ProcessMonsters);
 	DeleteMonsterList();
 
 	assert(ActiveMonsterCount <= MaxMonsters);
@@ -4206,6 +4406,7 @@ void FreeMonsters()
 {
 	for (CMonster &monsterType : LevelMonsterTypes) {
 		monsterType.animData = nullptr;
+		monsterType.trn = nullptr;
 		monsterType.corpseId = 0;
 		for (AnimStruct &animData : monsterType.anims) {
 			animData.sprites = std::nullopt;
@@ -4526,6 +4727,7 @@ void MissToMonst(Missile &missile, Point position)
 	monster.occupyTile(position, false);
 	monster.direction = missile.getDirection();
 	monster.position.tile = position;
+	UpdateMonsterSpatialIndex(monster);
 	M_StartStand(monster, monster.direction);
 	M_StartHit(monster, 0);
 
@@ -4571,6 +4773,7 @@ void MissToMonst(Missile &missile, Point position)
 		dMonster[oldPosition.x][oldPosition.y] = 0;
 		monster.position.tile = newPosition;
 		monster.position.future = newPosition;
+		UpdateMonsterSpatialIndex(monster);
 	}
 }
 
@@ -4976,6 +5179,7 @@ void Monster::occupyTile(Point tile, bool isMoving) const
 {
 	const auto id = static_cast<int16_t>(this->getId() + 1);
 	dMonster[tile.x][tile.y] = isMoving ? -id : id;
+	MarkTileOccupied(tile);
 }
 
 } // namespace devilution
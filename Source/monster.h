@@ -10,6 +10,7 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <string>
 
 #include <expected.hpp>
@@ -27,6 +28,7 @@
 #include "monstdat.h"
 #include "spelldat.h"
 #include "textdat.h"
+#include "utils/attributes.h"
 #include "utils/language.h"
 
 namespace devilution {
@@ -179,12 +181,15 @@ enum class MonsterSound : uint8_t {
 
 struct MonsterSpritesData {
 	static constexpr size_t MaxAnims = 6;
-	std::unique_ptr<std::byte[]> data;
+	std::shared_ptr<std::byte[]> data;
 	std::array<uint32_t, MaxAnims + 1> offsets;
 };
 
 struct CMonster {
-	std::unique_ptr<std::byte[]> animData;
+	/** @brief Sprite data, shared by all types on the level that use the same sprites. */
+	std::shared_ptr<std::byte[]> animData;
+	/** @brief Palette translation of this type, applied when drawing as the sprite data is shared. */
+	std::unique_ptr<uint8_t[]> trn;
 	AnimStruct anims[6];
 	std::unique_ptr<TSnd> sounds[4][2];
 
@@ -205,6 +210,12 @@ struct CMonster {
 	{
 		return anims[static_cast<int>(graphic)];
 	}
+
+	/**
+	 * @brief Returns the palette translation to draw the given sprites of this type with
+	 * @return nullptr if the sprites are drawn with their original colors
+	 */
+	[[nodiscard]] const uint8_t *getTRN(ClxSpriteList sprites) const;
 };
 
 extern CMonster LevelMonsterTypes[MaxLvlMTypes];
@@ -479,9 +490,9 @@ struct Monster { // note: missing field _mAFNum
 };
 
 extern size_t LevelMonsterTypeCount;
-extern Monster Monsters[MaxMonsters];
-extern unsigned ActiveMonsters[MaxMonsters];
-extern size_t ActiveMonsterCount;
+extern DVL_API_FOR_TEST Monster Monsters[MaxMonsters];
+extern DVL_API_FOR_TEST unsigned ActiveMonsters[MaxMonsters];
+extern DVL_API_FOR_TEST size_t ActiveMonsterCount;
 extern int MonsterKillCounts[NUM_MAX_MTYPES];
 extern bool sgbSaveSoundOn;
 
@@ -495,6 +506,11 @@ inline tl::expected<size_t, std::string> AddMonsterType(UniqueMonsterType unique
 }
 tl::expected<void, std::string> InitMonsterSND(CMonster &monsterType);
 tl::expected<void, std::string> InitMonsterGFX(CMonster &monsterType, MonsterSpritesData &&spritesData = {});
+/**
+ * @brief Starts reading the sprites of the level's monster types in the background,
+ * so that they are ready by the time `InitAllMonsterGFX` is called.
+ */
+void PrefetchMonsterGFX();
 tl::expected<void, std::string> InitAllMonsterGFX();
 void WeakenNaKrul();
 void InitGolems();
@@ -519,6 +535,15 @@ void AddDoppelganger(Monster &monster);
 void ApplyMonsterDamage(DamageType damageType, Monster &monster, int damage);
 bool M_Talker(const Monster &monster);
 void M_StartStand(Monster &monster, Direction md);
+/**
+ * @brief Moves the monster to its current tile in the spatial index used to pick enemies.
+ * Must be called whenever the tile of a monster changes.
+ */
+void UpdateMonsterSpatialIndex(const Monster &monster);
+/**
+ * @brief Rebuilds the spatial index used to pick enemies from the active monsters.
+ */
+void RebuildMonsterSpatialIndex();
 void M_ClearSquares(const Monster &monster);
 void M_GetKnockback(Monster &monster, WorldTilePosition attackerStartPos);
 void M_StartHit(Monster &monster, int dam);
@@ -0,0 +1,143 @@
+#include "mpq/mpq_block_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <ankerl/unordered_dense.h>
+
+#include "utils/sdl_mutex.h"
+
+namespace devilution {
+
+namespace {
+
+struct MpqBlockKeyHash {
+	using is_avalanching = void;
+
+	[[nodiscard]] uint64_t operator()(const MpqBlockKey &key) const noexcept
+	{
+		const uint64_t fileHash = ankerl::unordered_dense::hash<uint64_t> {}((static_cast<uint64_t>(key.archiveId) << 32) | key.fileNumber);
+		return ankerl::unordered_dense::hash<uint64_t> {}(fileHash ^ key.blockNumber);
+	}
+};
+
+struct CachedBlock {
+	MpqBlockKey key;
+	size_t size;
+	std::unique_ptr<uint8_t[]> data;
+};
+
+class MpqBlockCache {
+public:
+	bool Read(const MpqBlockKey &key, uint8_t *out, size_t size)
+	{
+		const auto it = index_.find(key);
+		if (it == index_.end() || it->second->size != size) {
+			++stats_.misses;
+			return false;
+		}
+		++stats_.hits;
+		// Move to the front of the LRU list.
+		blocks_.splice(blocks_.begin(), blocks_, it->second);
+		std::memcpy(out, it->second->data.get(), size);
+		return true;
+	}
+
+	void Insert(const MpqBlockKey &key, const uint8_t *data, size_t size)
+	{
+		if (size > stats_.capacityBytes)
+			return;
+		Erase(key);
+		EvictUntilFits(size);
+		CachedBlock &block = blocks_.emplace_front(CachedBlock { key, size, std::unique_ptr<uint8_t[]> { new uint8_t[size] } });
+		std::memcpy(block.data.get(), data, size);
+		index_.emplace(key, blocks_.begin());
+		stats_.sizeBytes += size;
+	}
+
+	void Clear()
+	{
+		blocks_.clear();
+		index_.clear();
+		stats_.sizeBytes = 0;
+	}
+
+	void SetCapacity(size_t capacityBytes)
+	{
+		stats_.capacityBytes = capacityBytes;
+		EvictUntilFits(0);
+	}
+
+	[[nodiscard]] const MpqBlockCacheStats &Stats() const
+	{
+		return stats_;
+	}
+
+private:
+	void Erase(const MpqBlockKey &key)
+	{
+		const auto it = index_.find(key);
+		if (it == index_.end())
+			return;
+		stats_.sizeBytes -= it->second->size;
+		blocks_.erase(it->second);
+		index_.erase(it);
+	}
+
+	void EvictUntilFits(size_t size)
+	{
+		while (!blocks_.empty() && stats_.sizeBytes + size > stats_.capacityBytes) {
+			const CachedBlock &block = blocks_.back();
+			stats_.sizeBytes -= block.size;
+			index_.erase(block.key);
+			blocks_.pop_back();
+			++stats_.evictions;
+		}
+	}
+
+	// Most recently used first.
+	std::list<CachedBlock> blocks_;
+	ankerl::unordered_dense::map<MpqBlockKey, std::list<CachedBlock>::iterator, MpqBlockKeyHash> index_;
+	MpqBlockCacheStats stats_ { 0, 0, 0, 0, DefaultMpqBlockCacheCapacity };
+};
+
+MpqBlockCache Cache;
+SdlMutex CacheMutex;
+
+} // namespace
+
+bool ReadCachedMpqBlock(const MpqBlockKey &key, uint8_t *out, size_t size)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	return Cache.Read(key, out, size);
+}
+
+void CacheMpqBlock(const MpqBlockKey &key, const uint8_t *data, size_t size)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	Cache.Insert(key, data, size);
+}
+
+void ClearMpqBlockCache()
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	Cache.Clear();
+}
+
+void SetMpqBlockCacheCapacity(size_t capacityBytes)
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	Cache.SetCapacity(capacityBytes);
+}
+
+MpqBlockCacheStats GetMpqBlockCacheStats()
+{
+	const std::lock_guard<SdlMutex> lock(CacheMutex);
+	return Cache.Stats();
+}
+
+} // namespace devilution
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace devilution {
+
+/**
+ * @brief Identifies a decompressed block (sector) of a file in an MPQ archive.
+ *
+ * `archiveId` is shared between an archive and all of its clones.
+ */
+struct MpqBlockKey {
+	uint32_t archiveId;
+	uint32_t fileNumber;
+	uint32_t blockNumber;
+
+	bool operator==(const MpqBlockKey &other) const = default;
+};
+
+struct MpqBlockCacheStats {
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t sizeBytes;
+	size_t capacityBytes;
+};
+
+constexpr size_t DefaultMpqBlockCacheCapacity = 2 * 1024 * 1024;
+
+/**
+ * @brief Copies a cached decompressed block into `out`.
+ *
+ * The cache is shared by all archives and is safe to use from multiple threads.
+ *
+ * @return false if the block is not in the cache.
+ */
+bool ReadCachedMpqBlock(const MpqBlockKey &key, uint8_t *out, size_t size);
+
+/** @brief Stores a decompressed block, evicting the least recently used ones as needed. */
+void CacheMpqBlock(const MpqBlockKey &key, const uint8_t *data, size_t size);
+
+/** @brief Drops all cached blocks. Called when archives are unloaded, as their blocks can no longer be read. */
+void ClearMpqBlockCache();
+
+/** @brief Sets the maximum total size of cached blocks in bytes, evicting blocks that no longer fit. 0 disables the cache. */
+void SetMpqBlockCacheCapacity(size_t capacityBytes);
+
+MpqBlockCacheStats GetMpqBlockCacheStats();
+
+} // namespace devilution
@@ -2,13 +2,78 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string_view>
 
 #include <libmpq/mpq.h>
 
+#include "utils/sdl_mutex.h"
+
 namespace devilution {
 
+namespace {
+
+uint32_t NextArchiveId = 0;
+
+// Idle clones beyond this are closed rather than kept open.
+constexpr size_t MaxIdleClones = 4;
+
+} // namespace
+
+class MpqArchiveClonePool {
+public:
+	std::unique_ptr<MpqArchive> Take()
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		if (idle_.empty())
+			return nullptr;
+		std::unique_ptr<MpqArchive> result = std::move(idle_.back());
+		idle_.pop_back();
+		return result;
+	}
+
+	void Return(std::unique_ptr<MpqArchive> &&archive)
+	{
+		const std::lock_guard<SdlMutex> lock(mutex_);
+		if (idle_.size() < MaxIdleClones)
+			idle_.push_back(std::move(archive));
+	}
+
+private:
+	SdlMutex mutex_;
+	std::vector<std::unique_ptr<MpqArchive>> idle_;
+};
+
+PooledMpqArchive::PooledMpqArchive(std::shared_ptr<MpqArchiveClonePool> pool, std::unique_ptr<MpqArchive> archive)
+    : pool_(std::move(pool))
+    , archive_(std::move(archive))
+{
+}
+
+PooledMpqArchive &PooledMpqArchive::operator=(PooledMpqArchive &&other) noexcept
+{
+	Release();
+	pool_ = std::move(other.pool_);
+	archive_ = std::move(other.archive_);
+	return *this;
+}
+
+PooledMpqArchive::~PooledMpqArchive()
+{
+	Release();
+}
+
+void PooledMpqArchive::Release()
+{
+	if (archive_ != nullptr && pool_ != nullptr)
+		pool_->Return(std::move(archive_));
+	archive_ = nullptr;
+	pool_ = nullptr;
+}
+
 std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 {
 	mpq_archive_s *archive;
@@ -18,7 +83,12 @@ std::optional<MpqArchive> MpqArchive::Open(const char *path, int32_t &error)
 			error = 0;
 		return std::nullopt;
 	}
-	return MpqArchive { std::string(path), archive };
+	std::shared_ptr<const MappedFile> mappedFile;
+#ifdef MMAP_MPQS
+	if (std::optional<MappedFile> mapped = MappedFile::Open(path); mapped.has_value())
+		mappedFile = std::make_shared<const MappedFile>(*std::move(mapped));
+#endif
+	return MpqArchive { std::string(path), NextArchiveId++, archive, std::move(mappedFile), std::make_shared<MpqArchiveClonePool>() };
 }
 
 std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
@@ -27,7 +97,22 @@ std::optional<MpqArchive> MpqArchive::Clone(int32_t &error)
 	error = libmpq__archive_dup(archive_, path_.c_str(), &copy);
 	if (error != 0)
 		return std::nullopt;
-	return MpqArchive { path_, copy };
+	// Clones do not share the pool: idle clones are owned by the pool,
+	// so a reference back to it would keep the pool and the archive file open forever.
+	return MpqArchive { path_, id_, copy, mappedFile_, nullptr };
+}
+
+PooledMpqArchive MpqArchive::BorrowClone(int32_t &error)
+{
+	error = 0;
+	std::unique_ptr<MpqArchive> clone = clonePool_ != nullptr ? clonePool_->Take() : nullptr;
+	if (clone == nullptr) {
+		std::optional<MpqArchive> newClone = Clone(error);
+		if (!newClone.has_value())
+			return {};
+		clone = std::make_unique<MpqArchive>(*std::move(newClone));
+	}
+	return PooledMpqArchive { clonePool_, std::move(clone) };
 }
 
 const char *MpqArchive::ErrorMessage(int32_t errorCode)
@@ -38,10 +123,13 @@ const char *MpqArchive::ErrorMessage(int32_t errorCode)
 MpqArchive &MpqArchive::operator=(MpqArchive &&other) noexcept
 {
 	path_ = std::move(other.path_);
+	id_ = other.id_;
 	if (archive_ != nullptr)
 		libmpq__archive_close(archive_);
 	archive_ = other.archive_;
 	other.archive_ = nullptr;
+	mappedFile_ = std::move(other.mappedFile_);
+	clonePool_ = std::move(other.clonePool_);
 	tmp_buf_ = std::move(other.tmp_buf_);
 	return *this;
 }
@@ -139,6 +227,40 @@ std::size_t MpqArchive::GetBlockSize(uint32_t fileNumber, uint32_t blockNumber,
 	return static_cast<size_t>(blockSize);
 }
 
+std::span<const std::byte> MpqArchive::GetStoredFileView(uint32_t fileNumber)
+{
+	if (mappedFile_ == nullptr)
+		return {};
+
+	uint32_t flag;
+	if (libmpq__file_compressed(archive_, fileNumber, &flag) != 0 || flag != 0)
+		return {};
+	if (libmpq__file_imploded(archive_, fileNumber, &flag) != 0 || flag != 0)
+		return {};
+	if (libmpq__file_encrypted(archive_, fileNumber, &flag) != 0 || flag != 0)
+		return {};
+
+	libmpq__off_t packedSize;
+	libmpq__off_t unpackedSize;
+	if (libmpq__file_size_packed(archive_, fileNumber, &packedSize) != 0
+	    || libmpq__file_size_unpacked(archive_, fileNumber, &unpackedSize) != 0
+	    || packedSize != unpackedSize)
+		return {};
+
+	// Block offsets are relative to the start of the archive, which may be embedded in a larger file.
+	libmpq__off_t archiveOffset;
+	libmpq__off_t fileOffset;
+	if (libmpq__archive_offset(archive_, &archiveOffset) != 0
+	    || libmpq__file_offset(archive_, fileNumber, &fileOffset) != 0)
+		return {};
+
+	const std::span<const std::byte> data = mappedFile_->data();
+	const auto offset = static_cast<uint64_t>(archiveOffset) + static_cast<uint64_t>(fileOffset);
+	if (offset > data.size() || static_cast<uint64_t>(unpackedSize) > data.size() - offset)
+		return {};
+	return data.subspan(static_cast<size_t>(offset), static_cast<size_t>(unpackedSize));
+}
+
 bool MpqArchive::HasFile(std::string_view filename) const
 {
 	std::uint32_t fileNumber;
@@ -4,12 +4,14 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "mpq/mpq_common.hpp"
+#include "utils/mapped_file.hpp"
 
 // Forward-declare so that we can avoid exposing libmpq.
 struct mpq_archive;
@@ -17,6 +19,34 @@ using mpq_archive_s = struct mpq_archive;
 
 namespace devilution {
 
+class MpqArchive;
+class MpqArchiveClonePool;
+
+/**
+ * @brief A clone of an archive borrowed from the archive's clone pool.
+ *
+ * The clone is for exclusive use by the borrower and goes back to the pool on destruction.
+ */
+class PooledMpqArchive {
+public:
+	PooledMpqArchive() = default;
+	PooledMpqArchive(std::shared_ptr<MpqArchiveClonePool> pool, std::unique_ptr<MpqArchive> archive);
+	PooledMpqArchive(PooledMpqArchive &&other) noexcept = default;
+	PooledMpqArchive &operator=(PooledMpqArchive &&other) noexcept;
+	~PooledMpqArchive();
+
+	[[nodiscard]] MpqArchive *get() const
+	{
+		return archive_.get();
+	}
+
+private:
+	void Release();
+
+	std::shared_ptr<MpqArchiveClonePool> pool_;
+	std::unique_ptr<MpqArchive> archive_;
+};
+
 class MpqArchive {
 public:
 	// If the file does not exist, returns nullopt without an error.
@@ -24,11 +54,24 @@ public:
 
 	std::optional<MpqArchive> Clone(int32_t &error);
 
+	/**
+	 * @brief Borrows a clone for use on another thread.
+	 *
+	 * Idle clones are kept in a pool owned by the archive and the borrowed clones,
+	 * so the archive file is only reopened when all of the existing clones are in use.
+	 * The pool and its clones are closed once the archive and every borrowed clone are destroyed.
+	 * Clones of clones are not pooled.
+	 */
+	PooledMpqArchive BorrowClone(int32_t &error);
+
 	static const char *ErrorMessage(int32_t errorCode);
 
 	MpqArchive(MpqArchive &&other) noexcept
 	    : path_(std::move(other.path_))
+	    , id_(other.id_)
 	    , archive_(other.archive_)
+	    , mappedFile_(std::move(other.mappedFile_))
+	    , clonePool_(std::move(other.clonePool_))
 	    , tmp_buf_(std::move(other.tmp_buf_))
 	{
 		other.archive_ = nullptr;
@@ -59,10 +102,40 @@ public:
 
 	bool HasFile(std::string_view filename) const;
 
+	/**
+	 * @brief Returns the contents of a file that is stored without compression or encryption,
+	 * directly from the memory-mapped archive.
+	 *
+	 * Returns an empty span if the archive is not memory-mapped or the file needs decoding.
+	 */
+	std::span<const std::byte> GetStoredFileView(uint32_t fileNumber);
+
+	// The memory mapping of the archive, shared with clones. May be `nullptr`.
+	[[nodiscard]] const std::shared_ptr<const MappedFile> &GetMappedFile() const
+	{
+		return mappedFile_;
+	}
+
+	// Path of the underlying archive file.
+	[[nodiscard]] const std::string &GetPath() const
+	{
+		return path_;
+	}
+
+	// Identifies the underlying archive file. Clones share the ID of the original.
+	[[nodiscard]] uint32_t Id() const
+	{
+		return id_;
+	}
+
 private:
-	MpqArchive(std::string path, mpq_archive_s *archive)
+	MpqArchive(std::string path, uint32_t id, mpq_archive_s *archive, std::shared_ptr<const MappedFile> mappedFile,
+	    std::shared_ptr<MpqArchiveClonePool> clonePool)
 	    : path_(std::move(path))
+	    , id_(id)
 	    , archive_(archive)
+	    , mappedFile_(std::move(mappedFile))
+	    , clonePool_(std::move(clonePool))
 	{
 	}
 
@@ -74,7 +147,10 @@ private:
 	}
 
 	std::string path_;
+	uint32_t id_;
 	mpq_archive_s *archive_;
+	std::shared_ptr<const MappedFile> mappedFile_;
+	std::shared_ptr<MpqArchiveClonePool> clonePool_;
 	std::vector<std::uint8_t> tmp_buf_;
 };
 
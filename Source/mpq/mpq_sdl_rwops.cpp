@@ -1,18 +1,23 @@
 #include "mpq/mpq_sdl_rwops.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
+#include "mpq/mpq_block_cache.hpp"
+
 namespace devilution {
 
 namespace {
 
 struct Data {
 	// File information:
-	std::optional<MpqArchive> ownedArchive;
+	PooledMpqArchive ownedArchive;
 	MpqArchive *mpqArchive;
 	uint32_t fileNumber;
 	size_t blockSize;
@@ -36,6 +41,18 @@ void SetData(struct SDL_RWops *context, Data *data)
 	context->hidden.unknown.data1 = data;
 }
 
+struct MappedViewData {
+	// Keeps the mapping alive for as long as the view is read from.
+	std::shared_ptr<const MappedFile> mapping;
+	std::span<const std::byte> view;
+	size_t position;
+};
+
+MappedViewData *GetMappedViewData(struct SDL_RWops *context)
+{
+	return reinterpret_cast<MappedViewData *>(context->hidden.unknown.data1);
+}
+
 #ifndef USE_SDL1
 using OffsetType = Sint64;
 using SizeType = size_t;
@@ -104,6 +121,10 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 		data.blockData = std::unique_ptr<uint8_t[]> { new uint8_t[data.blockSize] };
 	}
 
+	// Reading the rest of the file in one go (e.g. `LoadAsset`) will not revisit any blocks,
+	// so only piecewise (streaming) reads go through the block cache.
+	const bool useCache = totalSize < data.size - data.position;
+
 	uint32_t blockNumber = static_cast<uint32_t>(data.position / data.blockSize);
 	while (remainingSize > 0) {
 		if (data.position == data.size) {
@@ -113,10 +134,15 @@ static SizeType MpqFileRwRead(struct SDL_RWops *context, void *ptr, SizeType siz
 		const size_t currentBlockSize = blockNumber + 1 == data.numBlocks ? data.lastBlockSize : data.blockSize;
 
 		if (!data.blockRead) {
-			const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
-			if (error != 0) {
-				SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
-				return 0;
+			const MpqBlockKey key { data.mpqArchive->Id(), data.fileNumber, blockNumber };
+			if (!useCache || !ReadCachedMpqBlock(key, data.blockData.get(), currentBlockSize)) {
+				const int32_t error = data.mpqArchive->ReadBlock(data.fileNumber, blockNumber, data.blockData.get(), currentBlockSize);
+				if (error != 0) {
+					SDL_SetError("MpqFileRwRead ReadBlock: %s", MpqArchive::ErrorMessage(error));
+					return 0;
+				}
+				if (useCache)
+					CacheMpqBlock(key, data.blockData.get(), currentBlockSize);
 			}
 			data.blockRead = true;
 		}
@@ -150,6 +176,64 @@ static int MpqFileRwClose(struct SDL_RWops *context)
 	return 0;
 }
 
+#ifndef USE_SDL1
+static Sint64 MappedViewRwSize(struct SDL_RWops *context)
+{
+	return static_cast<Sint64>(GetMappedViewData(context)->view.size());
+}
+#endif
+
+static OffsetType MappedViewRwSeek(struct SDL_RWops *context, OffsetType offset, int whence)
+{
+	MappedViewData &data = *GetMappedViewData(context);
+	OffsetType newPosition;
+	switch (whence) {
+	case RW_SEEK_SET:
+		newPosition = offset;
+		break;
+	case RW_SEEK_CUR:
+		newPosition = static_cast<OffsetType>(data.position + offset);
+		break;
+	case RW_SEEK_END:
+		newPosition = static_cast<OffsetType>(data.view.size() + offset);
+		break;
+	default:
+		return -1;
+	}
+
+	if (newPosition < 0) {
+		SDL_SetError("MappedViewRwSeek beyond BOF (%d < 0)", static_cast<int>(newPosition));
+		return -1;
+	}
+
+	if (static_cast<size_t>(newPosition) > data.view.size()) {
+		SDL_SetError("MappedViewRwSeek beyond EOF (%d > %u)", static_cast<int>(newPosition), static_cast<unsigned>(data.view.size()));
+		return -1;
+	}
+
+	data.position = static_cast<size_t>(newPosition);
+	return newPosition;
+}
+
+static SizeType MappedViewRwRead(struct SDL_RWops *context, void *ptr, SizeType size, SizeType maxnum)
+{
+	MappedViewData &data = *GetMappedViewData(context);
+	if (size == 0)
+		return 0;
+	const size_t available = (data.view.size() - data.position) / size;
+	const size_t num = std::min<size_t>(maxnum, available);
+	std::memcpy(ptr, data.view.data() + data.position, num * size);
+	data.position += num * size;
+	return static_cast<SizeType>(num);
+}
+
+static int MappedViewRwClose(struct SDL_RWops *context)
+{
+	delete GetMappedViewData(context);
+	delete context;
+	return 0;
+}
+
 } // extern "C"
 
 } // namespace
@@ -175,12 +259,12 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 	int32_t error = 0;
 
 	if (threadsafe) {
-		data->ownedArchive = mpqArchive.Clone(error);
+		data->ownedArchive = mpqArchive.BorrowClone(error);
 		if (error != 0) {
 			SDL_SetError("MpqFileRwRead Clone: %s", MpqArchive::ErrorMessage(error));
 			return nullptr;
 		}
-		data->mpqArchive = &*data->ownedArchive;
+		data->mpqArchive = data->ownedArchive.get();
 	} else {
 		data->mpqArchive = &mpqArchive;
 	}
@@ -196,12 +280,14 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 	data->size = archive.GetUnpackedFileSize(fileNumber, error);
 	if (error != 0) {
 		SDL_SetError("MpqFileRwRead GetUnpackedFileSize: %s", MpqArchive::ErrorMessage(error));
+		archive.CloseBlockOffsetTable(fileNumber);
 		return nullptr;
 	}
 
 	const std::uint32_t numBlocks = archive.GetNumBlocks(fileNumber, error);
 	if (error != 0) {
 		SDL_SetError("MpqFileRwRead GetNumBlocks: %s", MpqArchive::ErrorMessage(error));
+		archive.CloseBlockOffsetTable(fileNumber);
 		return nullptr;
 	}
 	data->numBlocks = numBlocks;
@@ -209,6 +295,7 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 	const size_t blockSize = archive.GetBlockSize(fileNumber, 0, error);
 	if (error != 0) {
 		SDL_SetError("MpqFileRwRead GetBlockSize: %s", MpqArchive::ErrorMessage(error));
+		archive.CloseBlockOffsetTable(fileNumber);
 		return nullptr;
 	}
 	data->blockSize = blockSize;
@@ -217,6 +304,7 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 		data->lastBlockSize = archive.GetBlockSize(fileNumber, numBlocks - 1, error);
 		if (error != 0) {
 			SDL_SetError("MpqFileRwRead GetBlockSize: %s", MpqArchive::ErrorMessage(error));
+			archive.CloseBlockOffsetTable(fileNumber);
 			return nullptr;
 		}
 	} else {
@@ -230,4 +318,25 @@ SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, st
 	return result.release();
 }
 
+SDL_RWops *SDL_RWops_FromMappedView(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> view)
+{
+	auto result = std::make_unique<SDL_RWops>();
+	std::memset(result.get(), 0, sizeof(*result));
+
+#ifndef USE_SDL1
+	result->size = &MappedViewRwSize;
+	result->type = SDL_RWOPS_UNKNOWN;
+#else
+	result->type = 0;
+#endif
+
+	result->seek = &MappedViewRwSeek;
+	result->read = &MappedViewRwRead;
+	result->write = nullptr;
+	result->close = &MappedViewRwClose;
+
+	result->hidden.unknown.data1 = new MappedViewData { std::move(mapping), view, 0 };
+	return result.release();
+}
+
 } // namespace devilution
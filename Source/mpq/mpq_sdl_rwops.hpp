@@ -1,14 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <string_view>
 
 #include <SDL.h>
 
 #include "mpq/mpq_reader.hpp"
+#include "utils/mapped_file.hpp"
 
 namespace devilution {
 
 SDL_RWops *SDL_RWops_FromMpqFile(MpqArchive &mpqArchive, uint32_t fileNumber, std::string_view filename, bool threadsafe);
 
+/**
+ * @brief Reads a file stored uncompressed in a memory-mapped archive directly from the mapping.
+ *
+ * The returned handle shares ownership of `mapping`, so it stays readable after the archive is closed.
+ */
+SDL_RWops *SDL_RWops_FromMappedView(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> view);
+
 } // namespace devilution
@@ -852,6 +852,7 @@ void DeltaLoadMonsters(const DLevel &deltaLevel)
 			monster.position.tile = position;
 			monster.position.old = position;
 			monster.position.future = position;
+			UpdateMonsterSpatialIndex(monster);
 			if (monster.lightId != NO_LIGHT)
 				ChangeLightXY(monster.lightId, position);
 		}
@@ -1195,7 +1196,7 @@ size_t OnWalk(const TCmdLoc &message, Player &player)
 
 	if (gbBufferMsgs != 1 && player.isOnActiveLevel() && InDungeonBounds(position)) {
 		ClrPlrPath(player);
-		MakePlrPath(player, position, true);
+		MakePlrWalkPath(player, position);
 		player.destAction = ACTION_NONE;
 	}
 
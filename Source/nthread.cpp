@@ -13,6 +13,7 @@
 #include "diablo.h"
 #include "engine/animationinfo.h"
 #include "engine/demomode.h"
+#include "engine/profiler.hpp"
 #include "game_mode.hpp"
 #include "gmenu.h"
 #include "storm/storm_net.hpp"
@@ -75,6 +76,7 @@ void nthread_terminate_game(const char *pszFcn)
 
 uint32_t nthread_send_and_recv_turn(uint32_t curTurn, int turnDelta)
 {
+	DVL_PROFILE_ZONE(NetTurn);
 	uint32_t curTurnsInTransit;
 	if (!SNetGetTurnsInTransit(&curTurnsInTransit)) {
 		nthread_terminate_game("SNetGetTurnsInTransit");
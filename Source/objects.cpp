@@ -25,6 +25,7 @@
 #include "engine/load_cel.hpp"
 #include "engine/load_file.hpp"
 #include "engine/points_in_rectangle_range.hpp"
+#include "engine/profiler.hpp"
 #include "engine/random.hpp"
 #include "headless_mode.hpp"
 #include "inv.h"
@@ -34,6 +35,7 @@
 #include "levels/setmaps.h"
 #include "levels/themes.h"
 #include "levels/tile_properties.hpp"
+#include "levels/walkability.hpp"
 #include "lighting.h"
 #include "minitext.h"
 #include "missiles.h"
@@ -727,6 +729,7 @@ void AddCryptBook(_object_id ot, int v2, Point position)
 	AvailableObjects[0] = AvailableObjects[MAXOBJECTS - 1 - ActiveObjectCount];
 	ActiveObjects[ActiveObjectCount] = oi;
 	dObject[position.x][position.y] = oi + 1;
+	MarkTileOccupied(position);
 	Object &object = Objects[oi];
 	SetupObject(object, position, ot);
 	AddCryptObject(object, v2);
@@ -946,6 +949,8 @@ void AddChest(Object &chest)
 void ObjSetMicro(Point position, int pn)
 {
 	dPiece[position.x][position.y] = pn;
+	InvalidateLevelLayout();
+	ChangeLightsAt(position);
 }
 
 void DoorSet(Point position, bool isLeftDoor)
@@ -4001,6 +4006,7 @@ Object *AddObject(_object_id objType, Point objPos)
 	AvailableObjects[0] = AvailableObjects[MAXOBJECTS - 1 - ActiveObjectCount];
 	ActiveObjects[ActiveObjectCount] = oi;
 	dObject[objPos.x][objPos.y] = oi + 1;
+	MarkTileOccupied(objPos);
 	Object &object = Objects[oi];
 	SetupObject(object, objPos, objType);
 	switch (object._otype) {
@@ -4183,6 +4189,7 @@ void OperateTrap(Object &trap)
 
 void ProcessObjects()
 {
+	DVL_PROFILE_ZONE(ProcessObjects);
 	for (int i = 0; i < ActiveObjectCount; ++i) {
 		Object &object = Objects[ActiveObjects[i]];
 		switch (object._otype) {
@@ -4908,6 +4915,9 @@ void SyncNakrulRoom()
 	dPiece[UberRow][UberCol - 1] = 300;
 	dPiece[UberRow][UberCol - 2] = 299;
 	dPiece[UberRow][UberCol + 1] = 298;
+	InvalidateLevelLayout();
+	for (int col = UberCol - 2; col <= UberCol + 1; col++)
+		ChangeLightsAt({ UberRow, col });
 }
 
 } // namespace devilution
@@ -57,6 +57,18 @@ namespace devilution {
 #ifndef DEFAULT_PER_PIXEL_LIGHTING
 #define DEFAULT_PER_PIXEL_LIGHTING true
 #endif
+#ifndef DEFAULT_PARTIAL_REDRAW
+#define DEFAULT_PARTIAL_REDRAW false
+#endif
+#ifndef DEFAULT_FLOOR_CACHE
+#define DEFAULT_FLOOR_CACHE false
+#endif
+#ifndef DEFAULT_SPRITE_CACHE
+#define DEFAULT_SPRITE_CACHE false
+#endif
+#ifndef DEFAULT_MPQ_BLOCK_CACHE
+#define DEFAULT_MPQ_BLOCK_CACHE 2
+#endif
 
 namespace {
 
@@ -456,6 +468,8 @@ StartUpOptions::StartUpOptions()
               { StartUpSplash::TitleDialog, N_("Title Screen") },
               { StartUpSplash::None, N_("None") },
           })
+    , spriteCache("Sprite Cache", OptionEntryFlags::None, N_("Sprite Cache"), N_("Stores converted graphics in the settings folder so that they load faster next time."), DEFAULT_SPRITE_CACHE)
+    , mpqBlockCache("MPQ Block Cache", OptionEntryFlags::None, N_("MPQ Block Cache"), N_("Memory (MiB) kept for recently decompressed game data so that it is not decompressed again. 0 disables the cache."), DEFAULT_MPQ_BLOCK_CACHE, { 0, 1, 2, 4, 8, 16 })
 {
 }
 std::vector<OptionEntryBase *> StartUpOptions::GetEntries()
@@ -464,6 +478,8 @@ std::vector<OptionEntryBase *> StartUpOptions::GetEntries()
 		&diabloIntro,
 		&hellfireIntro,
 		&splash,
+		&spriteCache,
+		&mpqBlockCache,
 	};
 }
 
@@ -728,6 +744,8 @@ GraphicsOptions::GraphicsOptions()
     , brightness("Brightness Correction", OptionEntryFlags::Invisible, "Brightness Correction", "Brightness correction level.", 0)
     , zoom("Zoom", OptionEntryFlags::None, N_("Zoom"), N_("Zoom on when enabled."), false)
     , perPixelLighting("Per-pixel Lighting", OptionEntryFlags::None, N_("Per-pixel Lighting"), N_("Subtile lighting for smoother light gradients."), DEFAULT_PER_PIXEL_LIGHTING)
+    , partialRedraw("Partial Redraw", OptionEntryFlags::None, N_("Partial Redraw"), N_("Only redraws the parts of the game view that changed since the last frame. Saves power on slow devices."), DEFAULT_PARTIAL_REDRAW)
+    , floorCache("Floor Cache", OptionEntryFlags::None, N_("Floor Cache"), N_("Keeps the rendered floor between frames and only renders the floor tiles whose light changed."), DEFAULT_FLOOR_CACHE)
     , colorCycling("Color Cycling", OptionEntryFlags::None, N_("Color Cycling"), N_("Color cycling effect used for water, lava, and acid animation."), true)
     , alternateNestArt("Alternate nest art", OptionEntryFlags::OnlyHellfire | OptionEntryFlags::CantChangeInGame, N_("Alternate nest art"), N_("The game will use an alternative palette for Hellfire’s nest tileset."), false)
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -759,6 +777,8 @@ std::vector<OptionEntryBase *> GraphicsOptions::GetEntries()
 		&zoom,
 		&showFPS,
 		&perPixelLighting,
+		&partialRedraw,
+		&floorCache,
 		&colorCycling,
 		&alternateNestArt,
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -450,6 +450,10 @@ struct StartUpOptions : OptionCategoryBase {
 	/** @brief Play game intro video on hellfire startup. */
 	OptionEntryEnum<StartUpIntro> hellfireIntro;
 	OptionEntryEnum<StartUpSplash> splash;
+	/** @brief Keep the graphics converted from the legacy formats on disk to speed up loading. */
+	OptionEntryBoolean spriteCache;
+	/** @brief Size in MiB of the cache of decompressed MPQ blocks. */
+	OptionEntryInt<int> mpqBlockCache;
 };
 
 struct DiabloOptions : OptionCategoryBase {
@@ -530,6 +534,10 @@ struct GraphicsOptions : OptionCategoryBase {
 	OptionEntryBoolean zoom;
 	/** @brief Subtile lighting for smoother light gradients. */
 	OptionEntryBoolean perPixelLighting;
+	/** @brief Only redraw the parts of the game view that changed since the last frame. */
+	OptionEntryBoolean partialRedraw;
+	/** @brief Keep the rendered floor between frames and only render the floor tiles that changed. */
+	OptionEntryBoolean floorCache;
 	/** @brief Enable color cycling animations. */
 	OptionEntryBoolean colorCycling;
 	/** @brief Use alternate nest palette. */
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <vector>
 
 #include <fmt/core.h>
 
@@ -20,6 +21,7 @@
 #include "engine/backbuffer_state.hpp"
 #include "engine/load_cl2.hpp"
 #include "engine/load_file.hpp"
+#include "engine/path_impl.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/random.hpp"
 #include "engine/render/clx_render.hpp"
@@ -30,8 +32,10 @@
 #include "headless_mode.hpp"
 #include "help.h"
 #include "inv_iterators.hpp"
+#include "levels/room_graph.hpp"
 #include "levels/tile_properties.hpp"
 #include "levels/trigs.h"
+#include "levels/walkability.hpp"
 #include "lighting.h"
 #include "loadsave.h"
 #include "minitext.h"
@@ -1190,6 +1194,8 @@ void CheckNewPath(Player &player, bool pmWillBeCalled)
 			if (player._pmode == PM_STAND) {
 				StartStand(player, player._pdir);
 				player.destAction = ACTION_NONE;
+			} else if (player.walkpath[0] == WALK_NONE && player.walkDestination && player.destAction == ACTION_NONE) {
+				MakePlrWalkPath(player, *player.walkDestination);
 			}
 		}
 
@@ -1925,7 +1931,7 @@ void Player::UpdatePreviewCelSprite(_cmd_id cmdId, Point point, uint16_t wParam1
 
 	if (minimalWalkDistance >= 0 && position.future != point) {
 		int8_t testWalkPath[MaxPathLengthPlayer];
-		const int steps = FindPath(CanStep, [this](Point tile) { return PosOkPlayer(*this, tile); }, position.future, point, testWalkPath, MaxPathLengthPlayer);
+		const int steps = FindPlayerPath(*this, point, testWalkPath, MaxPathLengthPlayer);
 		if (steps == 0) {
 			// Can't walk to desired location => stand still
 			return;
@@ -2006,6 +2012,7 @@ void Player::occupyTile(Point tilePosition, bool isMoving) const
 	int16_t id = this->getId();
 	id += 1;
 	dPlayer[tilePosition.x][tilePosition.y] = isMoving ? -id : id;
+	MarkTileOccupied(tilePosition);
 }
 
 bool Player::isLevelOwnedByLocalClient() const
@@ -2508,6 +2515,7 @@ void InitPlayer(Player &player, bool firstTime)
 
 		SetPlayerOld(player);
 		player.walkpath[0] = WALK_NONE;
+		player.walkDestination = std::nullopt;
 		player.destAction = ACTION_NONE;
 
 		if (&player == MyPlayer) {
@@ -3067,6 +3075,7 @@ void ProcessPlayers()
 void ClrPlrPath(Player &player)
 {
 	memset(player.walkpath, WALK_NONE, sizeof(player.walkpath));
+	player.walkDestination = std::nullopt;
 }
 
 /**
@@ -3103,13 +3112,27 @@ bool PosOkPlayer(const Player &player, Point position)
 	return true;
 }
 
+int FindPlayerPath(const Player &player, Point destination, int8_t *path, size_t maxPathLength)
+{
+	const Walkability &walkability = GetWalkability();
+	return FindPath(
+	    [&walkability](Point startPosition, Point destinationPosition) { return walkability.canStep(startPosition, destinationPosition); },
+	    [&walkability, &player](Point position) {
+		    if (walkability.isTileVacant(position))
+			    return walkability.isTileNotSolid(position);
+		    return PosOkPlayer(player, position);
+	    },
+	    player.position.future, destination, path, maxPathLength);
+}
+
 void MakePlrPath(Player &player, Point targetPosition, bool endspace)
 {
+	player.walkDestination = std::nullopt;
 	if (player.position.future == targetPosition) {
 		return;
 	}
 
-	int path = FindPath(CanStep, [&player](Point position) { return PosOkPlayer(player, position); }, player.position.future, targetPosition, player.walkpath, MaxPathLengthPlayer);
+	int path = FindPlayerPath(player, targetPosition, player.walkpath, MaxPathLengthPlayer);
 	if (path == 0) {
 		return;
 	}
@@ -3121,6 +3144,32 @@ void MakePlrPath(Player &player, Point targetPosition, bool endspace)
 	player.walkpath[path] = WALK_NONE;
 }
 
+void MakePlrWalkPath(Player &player, Point targetPosition)
+{
+	// Number of waypoints to try walking to before giving up, when monsters or other players are in the way.
+	constexpr int MaxLegAttempts = 4;
+
+	MakePlrPath(player, targetPosition, true);
+	if (player.walkpath[0] != WALK_NONE || player.position.future == targetPosition)
+		return;
+
+	std::vector<RouteWaypoint> route;
+	if (!FindRoomRoute(player.position.future, targetPosition, route))
+		return;
+
+	// Walk to the furthest waypoint a path leads to, the next leg starting from there.
+	int attempts = 0;
+	for (auto waypoint = route.rbegin(); waypoint != route.rend() && attempts < MaxLegAttempts; ++waypoint) {
+		if (waypoint->steps > MaxPathLengthPlayer)
+			continue;
+		attempts++;
+		if (FindPlayerPath(player, waypoint->position, player.walkpath, MaxPathLengthPlayer) != 0) {
+			player.walkDestination = targetPosition;
+			return;
+		}
+	}
+}
+
 void CheckPlrSpell(bool isShiftHeld, SpellID spellID, SpellType spellType)
 {
 	bool addflag = false;
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <optional>
 #include <string_view>
 
 #include "diablo.h"
@@ -267,6 +268,8 @@ struct Player {
 	uint32_t _pExperience;
 	PLR_MODE _pmode;
 	int8_t walkpath[MaxPathLengthPlayer];
+	/** @brief Where the player keeps walking to once `walkpath` runs out, when it is further away than a path leads. */
+	std::optional<Point> walkDestination;
 	bool plractive;
 	action_id destAction;
 	int destParam1;
@@ -980,7 +983,18 @@ void StartWarpLvl(Player &player, size_t pidx);
 void ProcessPlayers();
 void ClrPlrPath(Player &player);
 bool PosOkPlayer(const Player &player, Point position);
+/**
+ * @brief Finds the shortest path the player can walk from their future position to `destination`, see `FindPath`.
+ */
+int FindPlayerPath(const Player &player, Point destination, int8_t *path, size_t maxPathLength);
 void MakePlrPath(Player &player, Point targetPosition, bool endspace);
+/**
+ * @brief Sets the player walking to `targetPosition`, even when no path of at most `MaxPathLengthPlayer` steps leads there.
+ *
+ * A destination out of reach of `MakePlrPath` is walked to in legs along the route found by `FindRoomRoute`, each leg
+ * planned when the previous one ends.
+ */
+void MakePlrWalkPath(Player &player, Point targetPosition);
 void CheckPlrSpell(bool isShiftHeld, SpellID spellID = MyPlayer->_pRSpell, SpellType spellType = MyPlayer->_pRSplType);
 void SyncPlrAnim(Player &player);
 void SyncInitPlrPos(Player &player);
@@ -1,10 +1,15 @@
 #include "itemlabels.h"
 
 #include <algorithm>
-#include <cmath>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -16,10 +21,10 @@
 #include "engine/render/primitive_render.hpp"
 #include "gmenu.h"
 #include "inv.h"
+#include "items.h"
 #include "options.h"
 #include "qol/stash.h"
 #include "stores.h"
-#include "utils/algorithm/container.hpp"
 #include "utils/format_int.hpp"
 #include "utils/language.h"
 
@@ -30,11 +35,57 @@ namespace {
 struct ItemLabel {
 	int id, width;
 	Point pos;
-	StringOrView text;
+	std::string_view text;
 };
 
 std::vector<ItemLabel> labelQueue;
 
+/**
+ * @brief Everything the label text of an item depends on, besides the language.
+ */
+struct LabelTextKey {
+	_item_indexes idx;
+	uint32_t seed;
+	uint16_t createInfo;
+	bool identified;
+	item_quality magical;
+	int uid;
+	/** Value of gold, 0 for other items. */
+	int goldValue;
+
+	bool operator==(const LabelTextKey &) const = default;
+};
+
+/**
+ * @brief The label text of an item and its width, kept until the item or the language changes.
+ */
+struct LabelText {
+	std::optional<LabelTextKey> key;
+	std::string text;
+	int width = 0;
+};
+
+std::array<LabelText, MAXITEMS + 1> labelTexts;
+
+/** The language of the texts in `labelTexts`. */
+std::string labelTextsLanguage;
+
+/**
+ * @brief A label of the last layout: where it was queued, and where the layout moved it to.
+ */
+struct LaidOutLabel {
+	int id, width;
+	Point queuedPos;
+	int x;
+};
+
+std::vector<LaidOutLabel> lastLayout;
+int lastLayoutLabelHeight = 0;
+
+/** Labels sorted from top to bottom, and the x ranges blocked by the labels above, reused between layouts. */
+std::vector<size_t> layoutOrder;
+std::vector<std::pair<int, int>> blockedRanges;
+
 bool highlightKeyPressed = false;
 bool isLabelHighlighted = false;
 std::array<std::optional<int>, ITEMTYPES> labelCenterOffsets;
@@ -51,29 +102,106 @@ int TextMarginBottom() { return IsSmallFontTall() ? 1 : 3; }
 int LabelHeight() { return (IsSmallFontTall() ? 16 : 11) + TextMarginBottom() + TextMarginTop(); }
 
 /**
- * @brief The set of used X coordinates for a certain Y coordinate.
+ * @brief Returns the label text of an item, only formatting it again when the item or the language changed.
  */
-class UsedX {
-public:
-	[[nodiscard]] bool contains(int val) const
-	{
-		return c_find(data_, val) != data_.end();
+const LabelText &GetLabelText(int id)
+{
+	if (GetLanguageCode() != labelTextsLanguage) {
+		labelTextsLanguage = GetLanguageCode();
+		for (LabelText &label : labelTexts)
+			label.key = std::nullopt;
 	}
 
-	void insert(int val)
-	{
-		if (!contains(val))
-			data_.push_back(val);
+	const Item &item = Items[id];
+	const bool isGold = item._itype == ItemType::Gold;
+	const LabelTextKey key { item.IDidx, item._iSeed, item._iCreateInfo, item._iIdentified, item._iMagical, item._iUid, isGold ? item._ivalue : 0 };
+	LabelText &label = labelTexts[id];
+	if (label.key == key)
+		return label;
+
+	label.key = key;
+	if (isGold)
+		label.text = fmt::format(fmt::runtime(_("{:s} gold")), FormatInteger(item._ivalue));
+	else
+		label.text = item.getName().str();
+	label.width = GetLineWidth(label.text) + MarginX * 2;
+	return label;
+}
+
+/**
+ * @brief Returns the position closest to `x` outside of all the open ranges in `blockedRanges`.
+ */
+int FindNearestFreeX(int x)
+{
+	std::sort(blockedRanges.begin(), blockedRanges.end());
+	int begin = std::numeric_limits<int>::min();
+	int end = std::numeric_limits<int>::min();
+	for (const auto &[rangeBegin, rangeEnd] : blockedRanges) {
+		if (rangeBegin >= end) {
+			// The previous ranges are merged, see if they contain `x`.
+			if (begin < x && x < end)
+				break;
+			begin = rangeBegin;
+		}
+		end = std::max(end, rangeEnd);
 	}
+	if (begin < x && x < end)
+		return x - begin <= end - x ? begin : end;
+	return x;
+}
 
-	void clear()
-	{
-		data_.clear();
+/**
+ * @brief Moves the queued labels sideways until none of them overlap.
+ *
+ * The labels are placed from top to bottom, each one moving to the free position closest to where it was queued.
+ * Only the placed labels that are close enough vertically to overlap it are checked.
+ */
+void LayOutLabels(int labelHeight)
+{
+	layoutOrder.resize(labelQueue.size());
+	std::iota(layoutOrder.begin(), layoutOrder.end(), 0);
+	std::stable_sort(layoutOrder.begin(), layoutOrder.end(), [](size_t a, size_t b) { return labelQueue[a].pos.y < labelQueue[b].pos.y; });
+
+	size_t firstOverlapping = 0;
+	for (size_t i = 0; i < layoutOrder.size(); i++) {
+		ItemLabel &label = labelQueue[layoutOrder[i]];
+		while (label.pos.y - labelQueue[layoutOrder[firstOverlapping]].pos.y >= labelHeight + BorderY)
+			firstOverlapping++;
+
+		const int width = label.width + BorderX + MarginX * 2;
+		blockedRanges.clear();
+		for (size_t j = firstOverlapping; j < i; j++) {
+			const ItemLabel &other = labelQueue[layoutOrder[j]];
+			blockedRanges.emplace_back(other.pos.x - width, other.pos.x + other.width + BorderX + MarginX * 2);
+		}
+		label.pos.x = FindNearestFreeX(label.pos.x);
 	}
+}
 
-private:
-	std::vector<int> data_;
-};
+/**
+ * @brief Moves the queued labels apart, reusing the last layout while the same labels are queued at the same positions.
+ */
+void PlaceLabels(int labelHeight)
+{
+	const bool unchanged = labelHeight == lastLayoutLabelHeight
+	    && std::equal(labelQueue.begin(), labelQueue.end(), lastLayout.begin(), lastLayout.end(),
+	        [](const ItemLabel &label, const LaidOutLabel &laidOut) {
+		        return label.id == laidOut.id && label.width == laidOut.width && label.pos == laidOut.queuedPos;
+	        });
+	if (unchanged) {
+		for (size_t i = 0; i < labelQueue.size(); i++)
+			labelQueue[i].pos.x = lastLayout[i].x;
+		return;
+	}
+
+	lastLayout.clear();
+	for (const ItemLabel &label : labelQueue)
+		lastLayout.push_back(LaidOutLabel { label.id, label.width, label.pos, 0 });
+	LayOutLabels(labelHeight);
+	for (size_t i = 0; i < labelQueue.size(); i++)
+		lastLayout[i].x = labelQueue[i].pos.x;
+	lastLayoutLabelHeight = labelHeight;
+}
 
 } // namespace
 
@@ -108,15 +236,8 @@ void AddItemToLabelQueue(int id, Point position)
 		return;
 	Item &item = Items[id];
 
-	StringOrView textOnGround;
-	if (item._itype == ItemType::Gold) {
-		textOnGround = fmt::format(fmt::runtime(_("{:s} gold")), FormatInteger(item._ivalue));
-	} else {
-		textOnGround = item.getName();
-	}
-
-	int nameWidth = GetLineWidth(textOnGround);
-	nameWidth += MarginX * 2;
+	const LabelText &text = GetLabelText(id);
+	const int nameWidth = text.width;
 	const int index = ItemCAnimTbl[item._iCurs];
 	if (!labelCenterOffsets[index]) {
 		const auto [xBegin, xEnd] = ClxMeasureSolidHorizontalBounds((*item.AnimInfo.sprites)[item.AnimInfo.currentFrame]);
@@ -130,7 +251,7 @@ void AddItemToLabelQueue(int id, Point position)
 	}
 	position.x -= nameWidth / 2;
 	position.y -= LabelHeight();
-	labelQueue.push_back(ItemLabel { id, nameWidth, position, std::move(textOnGround) });
+	labelQueue.push_back(ItemLabel { id, nameWidth, position, text.text });
 }
 
 bool IsMouseOverGameArea()
@@ -151,40 +272,9 @@ void DrawItemNameLabels(const Surface &out)
 	isLabelHighlighted = false;
 	if (labelQueue.empty())
 		return;
-	UsedX usedX;
 	const int labelHeight = LabelHeight();
 	const int labelMarginTop = TextMarginTop();
-
-	for (unsigned i = 0; i < labelQueue.size(); ++i) {
-		usedX.clear();
-
-		bool canShow;
-		do {
-			canShow = true;
-			for (unsigned j = 0; j < i; ++j) {
-				ItemLabel &a = labelQueue[i];
-				const ItemLabel &b = labelQueue[j];
-				if (std::abs(b.pos.y - a.pos.y) < labelHeight + BorderY) {
-					const int widthA = a.width + BorderX + MarginX * 2;
-					const int widthB = b.width + BorderX + MarginX * 2;
-					int newpos = b.pos.x;
-					if (b.pos.x >= a.pos.x && b.pos.x - a.pos.x < widthA) {
-						newpos -= widthA;
-						if (usedX.contains(newpos))
-							newpos = b.pos.x + widthB;
-					} else if (b.pos.x < a.pos.x && a.pos.x - b.pos.x < widthB) {
-						newpos += widthB;
-						if (usedX.contains(newpos))
-							newpos = b.pos.x - widthA;
-					} else
-						continue;
-					canShow = false;
-					a.pos.x = newpos;
-					usedX.insert(newpos);
-				}
-			}
-		} while (!canShow);
-	}
+	PlaceLabels(labelHeight);
 
 	for (const ItemLabel &label : labelQueue) {
 		const Item &item = Items[label.id];
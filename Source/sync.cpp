@@ -194,6 +194,7 @@ void SyncMonster(bool isOwner, const TSyncMonster &monsterSync)
 		M_ClearSquares(monster);
 		monster.occupyTile(position, false);
 		monster.position.tile = position;
+		UpdateMonsterSpatialIndex(monster);
 		if (monster.lightId != NO_LIGHT)
 			ChangeLightXY(monster.lightId, position);
 		decode_enemy(monster, enemyId);
@@ -29,6 +29,13 @@ std::string_view Dirname(std::string_view path);
 bool FileExistsAndIsWriteable(const char *path);
 bool GetFileSize(const char *path, std::uintmax_t *size);
 
+/**
+ * @brief Returns the last modification time of a file, in a platform-specific unit.
+ *
+ * Only meant to detect changes by comparing it to an earlier result.
+ */
+bool GetFileModificationTime(const char *path, std::int64_t *time);
+
 /**
  * @brief Creates a single directory (non-recursively).
  *
@@ -0,0 +1,110 @@
+#include "utils/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "utils/log.hpp"
+
+#if defined(_WIN32) && !defined(__UWP__) && !defined(NXDK)
+#define DEVILUTIONX_MAPPED_FILE_WIN32
+// Suppress definitions of `min` and `max` macros by <windows.h>:
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "utils/file_util.h"
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__3DS__) && !defined(__vita__) && !defined(__SWITCH__)
+#define DEVILUTIONX_MAPPED_FILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace devilution {
+
+std::optional<MappedFile> MappedFile::Open(const char *path)
+{
+#if defined(DEVILUTIONX_MAPPED_FILE_POSIX)
+	const int fd = ::open(path, O_RDONLY);
+	if (fd == -1)
+		return std::nullopt;
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return std::nullopt;
+	}
+	const auto size = static_cast<size_t>(st.st_size);
+	void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (data == MAP_FAILED) {
+		LogVerbose("mmap({}) failed", path);
+		return std::nullopt;
+	}
+	return MappedFile { static_cast<const std::byte *>(data), size };
+#elif defined(DEVILUTIONX_MAPPED_FILE_WIN32)
+#ifdef DEVILUTIONX_WINDOWS_NO_WCHAR
+	HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+	const auto pathUtf16 = ToWideChar(path);
+	if (pathUtf16 == nullptr)
+		return std::nullopt;
+	HANDLE file = ::CreateFileW(&pathUtf16[0], GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return std::nullopt;
+	LARGE_INTEGER fileSize;
+	if (::GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart <= 0 || static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX) {
+		::CloseHandle(file);
+		return std::nullopt;
+	}
+	HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	::CloseHandle(file);
+	if (mapping == NULL) {
+		LogVerbose("CreateFileMapping({}) failed: {}", path, ::GetLastError());
+		return std::nullopt;
+	}
+	void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	// The view keeps its own reference to the mapping.
+	::CloseHandle(mapping);
+	if (data == nullptr) {
+		LogVerbose("MapViewOfFile({}) failed: {}", path, ::GetLastError());
+		return std::nullopt;
+	}
+	return MappedFile { static_cast<const std::byte *>(data), static_cast<size_t>(fileSize.QuadPart) };
+#else
+	return std::nullopt;
+#endif
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+	Unmap();
+	data_ = other.data_;
+	size_ = other.size_;
+	other.data_ = nullptr;
+	other.size_ = 0;
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	Unmap();
+}
+
+void MappedFile::Unmap()
+{
+	if (data_ == nullptr)
+		return;
+#if defined(DEVILUTIONX_MAPPED_FILE_POSIX)
+	::munmap(const_cast<std::byte *>(data_), size_);
+#elif defined(DEVILUTIONX_MAPPED_FILE_WIN32)
+	::UnmapViewOfFile(data_);
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+
+} // namespace devilution
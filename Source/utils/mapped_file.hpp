@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+namespace devilution {
+
+/**
+ * @brief A read-only memory mapping of an entire file.
+ *
+ * Only available on platforms with `mmap` or `MapViewOfFile`,
+ * `Open` returns `std::nullopt` elsewhere.
+ */
+class MappedFile {
+public:
+	static std::optional<MappedFile> Open(const char *path);
+
+	MappedFile(MappedFile &&other) noexcept
+	    : data_(other.data_)
+	    , size_(other.size_)
+	{
+		other.data_ = nullptr;
+		other.size_ = 0;
+	}
+
+	MappedFile &operator=(MappedFile &&other) noexcept;
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	~MappedFile();
+
+	[[nodiscard]] std::span<const std::byte> data() const
+	{
+		return { data_, size_ };
+	}
+
+private:
+	MappedFile(const std::byte *data, size_t size)
+	    : data_(data)
+	    , size_(size)
+	{
+	}
+
+	void Unmap();
+
+	const std::byte *data_;
+	size_t size_;
+};
+
+} // namespace devilution
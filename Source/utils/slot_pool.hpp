@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "appfat.h"
+#include "utils/attributes.h"
+
+namespace devilution {
+
+/**
+ * @brief A list of elements stored in fixed-size blocks of slots, kept in insertion order.
+ *
+ * Removed elements leave their slot on a free list for the next insertion to reuse, so once the pool
+ * has grown to its peak size, adding and removing elements no longer allocates.
+ * Elements never move: pointers to an element stay valid until it is removed.
+ *
+ * Iteration visits the elements in insertion order, including elements appended while iterating.
+ *
+ * @tparam T element type.
+ * @tparam BlockSize number of slots allocated at once.
+ */
+template <class T, size_t BlockSize>
+class SlotPool {
+	using SlotIndex = uint32_t;
+	static constexpr SlotIndex NoSlot = std::numeric_limits<SlotIndex>::max();
+
+	template <bool IsConst>
+	class Iterator {
+		using Pool = std::conditional_t<IsConst, const SlotPool, SlotPool>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const T *, T *>;
+		using reference = std::conditional_t<IsConst, const T &, T &>;
+
+		Iterator() = default;
+
+		Iterator(Pool *pool, SlotIndex index)
+		    : pool_(pool)
+		    , index_(index)
+		{
+		}
+
+		reference operator*() const
+		{
+			return *pool_->slot(index_).ptr();
+		}
+
+		pointer operator->() const
+		{
+			return pool_->slot(index_).ptr();
+		}
+
+		Iterator &operator++()
+		{
+			index_ = pool_->slot(index_).next;
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto copy = *this;
+			++(*this);
+			return copy;
+		}
+
+		bool operator==(const Iterator &other) const
+		{
+			return index_ == other.index_;
+		}
+
+		bool operator!=(const Iterator &other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		Pool *pool_ = nullptr;
+		SlotIndex index_ = NoSlot;
+	};
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+	using size_type = size_t;
+	using iterator = Iterator</*IsConst=*/false>;
+	using const_iterator = Iterator</*IsConst=*/true>;
+
+	SlotPool() = default;
+	SlotPool(const SlotPool &) = delete;
+	SlotPool &operator=(const SlotPool &) = delete;
+
+	~SlotPool()
+	{
+		clear();
+	}
+
+	[[nodiscard]] iterator begin() { return { this, head_ }; }
+	[[nodiscard]] const_iterator begin() const { return { this, head_ }; }
+	[[nodiscard]] const_iterator cbegin() const { return begin(); }
+
+	[[nodiscard]] iterator end() { return { this, NoSlot }; }
+	[[nodiscard]] const_iterator end() const { return { this, NoSlot }; }
+	[[nodiscard]] const_iterator cend() const { return end(); }
+
+	[[nodiscard]] size_t size() const { return size_; }
+
+	[[nodiscard]] bool empty() const DVL_PURE { return size_ == 0; }
+
+	[[nodiscard]] size_t max_size() const // NOLINT(readability-identifier-naming)
+	{
+		return NoSlot;
+	}
+
+	/** @brief Number of slots allocated, used or not. */
+	[[nodiscard]] size_t capacity() const { return blocks_.size() * BlockSize; }
+
+	[[nodiscard]] T &front() { return *slot(head_).ptr(); }
+	[[nodiscard]] const T &front() const { return *slot(head_).ptr(); }
+
+	[[nodiscard]] T &back() { return *slot(tail_).ptr(); }
+	[[nodiscard]] const T &back() const { return *slot(tail_).ptr(); }
+
+	void push_back(const T &value) // NOLINT(readability-identifier-naming)
+	{
+		emplace_back(value);
+	}
+
+	template <typename... Args>
+	T &emplace_back(Args &&...args) // NOLINT(readability-identifier-naming)
+	{
+		if (freeHead_ == NoSlot)
+			addBlock();
+		const SlotIndex index = freeHead_;
+		Slot &newSlot = slot(index);
+		T *element = ::new (newSlot.storage) T(std::forward<Args>(args)...);
+		freeHead_ = newSlot.next;
+
+		newSlot.prev = tail_;
+		newSlot.next = NoSlot;
+		if (tail_ != NoSlot)
+			slot(tail_).next = index;
+		else
+			head_ = index;
+		tail_ = index;
+		++size_;
+		return *element;
+	}
+
+	/** @brief Removes the elements matching the predicate, keeping the order of the others. */
+	template <typename Predicate>
+	size_t remove_if(Predicate &&predicate) // NOLINT(readability-identifier-naming)
+	{
+		size_t removed = 0;
+		for (SlotIndex index = head_; index != NoSlot;) {
+			const SlotIndex next = slot(index).next;
+			if (predicate(*slot(index).ptr())) {
+				release(index);
+				++removed;
+			}
+			index = next;
+		}
+		return removed;
+	}
+
+	/** @brief Removes all elements, keeping the allocated blocks for reuse. */
+	void clear()
+	{
+		for (SlotIndex index = head_; index != NoSlot;) {
+			const SlotIndex next = slot(index).next;
+			release(index);
+			index = next;
+		}
+	}
+
+private:
+	struct Slot {
+		alignas(alignof(T)) std::byte storage[sizeof(T)];
+		SlotIndex prev;
+		SlotIndex next;
+
+		[[nodiscard]] const T *ptr() const
+		{
+			return std::launder(reinterpret_cast<const T *>(storage));
+		}
+
+		[[nodiscard]] T *ptr()
+		{
+			return std::launder(reinterpret_cast<T *>(storage));
+		}
+	};
+	using Block = std::array<Slot, BlockSize>;
+
+	[[nodiscard]] Slot &slot(SlotIndex index)
+	{
+		return (*blocks_[index / BlockSize])[index % BlockSize];
+	}
+
+	[[nodiscard]] const Slot &slot(SlotIndex index) const
+	{
+		return (*blocks_[index / BlockSize])[index % BlockSize];
+	}
+
+	void addBlock()
+	{
+		if (capacity() + BlockSize > max_size())
+			app_fatal("SlotPool is full");
+		const auto first = static_cast<SlotIndex>(capacity());
+		blocks_.emplace_back(std::make_unique<Block>());
+		for (SlotIndex i = BlockSize; i-- > 0;) {
+			slot(first + i).next = freeHead_;
+			freeHead_ = first + i;
+		}
+	}
+
+	void release(SlotIndex index)
+	{
+		Slot &oldSlot = slot(index);
+		std::destroy_at(oldSlot.ptr());
+		if (oldSlot.prev != NoSlot)
+			slot(oldSlot.prev).next = oldSlot.next;
+		else
+			head_ = oldSlot.next;
+		if (oldSlot.next != NoSlot)
+			slot(oldSlot.next).prev = oldSlot.prev;
+		else
+			tail_ = oldSlot.prev;
+		oldSlot.next = freeHead_;
+		freeHead_ = index;
+		--size_;
+	}
+
+	std::vector<std::unique_ptr<Block>> blocks_;
+	SlotIndex head_ = NoSlot;
+	SlotIndex tail_ = NoSlot;
+	SlotIndex freeHead_ = NoSlot;
+	size_t size_ = 0;
+};
+
+} // namespace devilution
@@ -1,5 +1,8 @@
 #include "vision.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 
@@ -19,7 +22,7 @@ namespace {
  * drawing algorithm, which is suitable for integer arithmetic:
  * https://en.wikipedia.org/wiki/Bresenham's_line_algorithm
  */
-const DisplacementOf<int8_t> VisionRays[23][15] = {
+constexpr DisplacementOf<int8_t> VisionRays[23][15] = {
 	// clang-format off
 	{ { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 }, { 8, 0 }, { 9, 0 }, { 10,  0 }, { 11,  0 }, { 12,  0 }, { 13,  0 }, { 14,  0 }, { 15,  0 } },
 	{ { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 }, { 8, 1 }, { 9, 1 }, { 10,  1 }, { 11,  1 }, { 12,  1 }, { 13,  1 }, { 14,  1 }, { 15,  1 } },
@@ -46,6 +49,95 @@ const DisplacementOf<int8_t> VisionRays[23][15] = {
 	{ { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 }, { 0, 7 }, { 0, 8 }, { 0, 9 }, {  0, 10 }, {  0, 11 }, {  0, 12 }, {  0, 13 }, {  0, 14 }, {  0, 15 } },
 	// clang-format on
 };
+
+// Adjustment to a ray length to ensure all rays lie on an
+// accurate circle
+constexpr uint8_t RayLenAdj[23] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 4, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0 };
+static_assert(std::size(RayLenAdj) == std::size(VisionRays));
+
+constexpr size_t MaxVisionRayNodes = std::size(VisionRays) * std::size(VisionRays[0]);
+
+/**
+ * @brief A point of the vision rays. Rays starting with the same points
+ * share their nodes, so those points are only traced once.
+ */
+struct VisionRayNode {
+	DisplacementOf<int8_t> offset;
+	/** @brief Smallest radius at which at least one ray reaches this point. */
+	uint8_t minRadius;
+	/** @brief Index of the first node that doesn't continue a ray through this point. */
+	uint16_t next;
+};
+
+/** @brief The vision rays merged into a tree, stored in pre-order. */
+struct VisionRayTree {
+	std::array<VisionRayNode, MaxVisionRayNodes> nodes;
+	size_t size;
+};
+
+struct VisionRayTrieNode {
+	DisplacementOf<int8_t> offset;
+	uint8_t minRadius;
+	int firstChild;
+	int nextSibling;
+};
+
+using VisionRayTrie = std::array<VisionRayTrieNode, MaxVisionRayNodes + 1>;
+
+constexpr void FlattenVisionRayTrie(const VisionRayTrie &trie, int trieNode, VisionRayTree &tree)
+{
+	for (int child = trie[trieNode].firstChild; child != -1; child = trie[child].nextSibling) {
+		VisionRayNode &node = tree.nodes[tree.size++];
+		node.offset = trie[child].offset;
+		node.minRadius = trie[child].minRadius;
+		FlattenVisionRayTrie(trie, child, tree);
+		node.next = static_cast<uint16_t>(tree.size);
+	}
+}
+
+constexpr VisionRayTree BuildVisionRayTree()
+{
+	// The root (index 0) is the observer's position
+	VisionRayTrie trie {};
+	int trieSize = 1;
+	trie[0] = { {}, 0, -1, -1 };
+
+	for (size_t j = 0; j < std::size(VisionRays); j++) {
+		int parent = 0;
+		for (size_t k = 0; k < std::size(VisionRays[j]); k++) {
+			const DisplacementOf<int8_t> relRayPoint = VisionRays[j][k];
+			if (relRayPoint == DisplacementOf<int8_t> {})
+				break;
+			// A ray reaches its k-th point when radius - RayLenAdj[j] > k
+			const auto minRadius = static_cast<uint8_t>(k + 1 + RayLenAdj[j]);
+
+			int lastChild = -1;
+			int node = trie[parent].firstChild;
+			while (node != -1 && trie[node].offset != relRayPoint) {
+				lastChild = node;
+				node = trie[node].nextSibling;
+			}
+			if (node == -1) {
+				node = trieSize++;
+				trie[node] = { relRayPoint, minRadius, -1, -1 };
+				if (lastChild == -1)
+					trie[parent].firstChild = node;
+				else
+					trie[lastChild].nextSibling = node;
+			} else {
+				trie[node].minRadius = std::min(trie[node].minRadius, minRadius);
+			}
+			parent = node;
+		}
+	}
+
+	VisionRayTree tree {};
+	FlattenVisionRayTrie(trie, 0, tree);
+	return tree;
+}
+
+constexpr VisionRayTree VisionRayNodes = BuildVisionRayTree();
+
 } // namespace
 
 void DoVision(Point position, uint8_t radius,
@@ -56,65 +148,74 @@ void DoVision(Point position, uint8_t radius,
 {
 	markVisibleFn(position);
 
-	// Adjustment to a ray length to ensure all rays lie on an
-	// accurate circle
-	constexpr uint8_t RayLenAdj[23] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 4, 3, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0 };
-	static_assert(std::size(RayLenAdj) == std::size(VisionRays));
-
 	// Four quadrants on a circle
 	constexpr Displacement Quadrants[] = { { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
 
 	// Loop over quadrants and mirror rays for each one
 	for (const auto &quadrant : Quadrants) {
-		// Cast a ray for a quadrant
-		for (unsigned int j = 0; j < std::size(VisionRays); j++) {
-			const int rayLen = radius - RayLenAdj[j];
-			for (int k = 0; k < rayLen; k++) {
-				const auto &relRayPoint = VisionRays[j][k];
-				// Calculate the next point on a ray in the quadrant
-				const Point rayPoint = position + relRayPoint * quadrant;
-				if (!inBoundsFn(rayPoint)) break;
-
-				// We've cast an approximated ray on an integer 2D
-				// grid, so we need to check if a ray can pass through
-				// the diagonally adjacent tiles. For example, consider
-				// this case:
-				//
-				//        #?
-				//       ↗ #
-				//     x
-				//
-				// The ray is cast from the observer 'x', and reaches
-				// the '?', but diagonally adjacent tiles '#' do not
-				// pass the light, so the '?' should not be visible
-				// for the 2D observer.
-				//
-				// The trick is to perform two additional visibility
-				// checks for the diagonally adjacent tiles, but only
-				// for the rays that are not parallel to the X or Y
-				// coordinate lines. Parallel rays, which have a 0 in
-				// one of their coordinate components, do not require
-				// any additional adjacent visibility checks, and the
-				// tile, hit by the ray, is always considered visible.
-				//
-				if (relRayPoint.deltaX > 0 && relRayPoint.deltaY > 0) {
-					const Displacement adjacent1 = { -quadrant.deltaX, 0 };
-					const Displacement adjacent2 = { 0, -quadrant.deltaY };
-
-					// If diagonally adjacent tiles do not pass the
-					// light further, we are done with this ray.
-					const bool passesLight = (passesLightFn(rayPoint + adjacent1) || passesLightFn(rayPoint + adjacent2));
-					if (!passesLight) break;
-				}
-				markVisibleFn(rayPoint);
+		// Cast all rays for a quadrant, skipping the rest of a ray
+		// (and all other rays continuing from the same point) once
+		// it is blocked
+		for (size_t i = 0; i < VisionRayNodes.size;) {
+			const VisionRayNode &node = VisionRayNodes.nodes[i];
+			if (radius < node.minRadius) {
+				i = node.next;
+				continue;
+			}
+			const auto &relRayPoint = node.offset;
+			// Calculate the next point on a ray in the quadrant
+			const Point rayPoint = position + relRayPoint * quadrant;
+			if (!inBoundsFn(rayPoint)) {
+				i = node.next;
+				continue;
+			}
 
-				// If the tile does not pass the light further, we are
-				// done with this ray.
-				const bool passesLight = passesLightFn(rayPoint);
-				if (!passesLight) break;
+			// We've cast an approximated ray on an integer 2D
+			// grid, so we need to check if a ray can pass through
+			// the diagonally adjacent tiles. For example, consider
+			// this case:
+			//
+			//        #?
+			//       ↗ #
+			//     x
+			//
+			// The ray is cast from the observer 'x', and reaches
+			// the '?', but diagonally adjacent tiles '#' do not
+			// pass the light, so the '?' should not be visible
+			// for the 2D observer.
+			//
+			// The trick is to perform two additional visibility
+			// checks for the diagonally adjacent tiles, but only
+			// for the rays that are not parallel to the X or Y
+			// coordinate lines. Parallel rays, which have a 0 in
+			// one of their coordinate components, do not require
+			// any additional adjacent visibility checks, and the
+			// tile, hit by the ray, is always considered visible.
+			//
+			if (relRayPoint.deltaX > 0 && relRayPoint.deltaY > 0) {
+				const Displacement adjacent1 = { -quadrant.deltaX, 0 };
+				const Displacement adjacent2 = { 0, -quadrant.deltaY };
 
-				markTransparentFn(rayPoint);
+				// If diagonally adjacent tiles do not pass the
+				// light further, we are done with this ray.
+				const bool passesLight = (passesLightFn(rayPoint + adjacent1) || passesLightFn(rayPoint + adjacent2));
+				if (!passesLight) {
+					i = node.next;
+					continue;
+				}
+			}
+			markVisibleFn(rayPoint);
+
+			// If the tile does not pass the light further, we are
+			// done with this ray.
+			const bool passesLight = passesLightFn(rayPoint);
+			if (!passesLight) {
+				i = node.next;
+				continue;
 			}
+
+			markTransparentFn(rayPoint);
+			i++;
 		}
 	}
 }
@@ -0,0 +1,185 @@
+#include "engine/clx_cache.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/clx_sprite.hpp"
+#include "options.h"
+#include "utils/file_util.h"
+#include "utils/paths.h"
+#include "utils/str_cat.hpp"
+
+namespace devilution {
+namespace {
+
+/** @brief A list with a single 2x1 sprite. */
+const std::vector<uint8_t> SpriteListData {
+	1, 0, 0, 0,             // number of sprites
+	12, 0, 0, 0,            // sprite offset
+	20, 0, 0, 0,            // end offset
+	6, 0, 2, 0, 1, 0,       // sprite header: header size, width, height
+	0xFE, 42,               // 2 pixels of color 42
+};
+
+class ClxCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		const std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+		prefPath_ = StrCat(paths::BasePath(), "Test_ClxCache_", name);
+		RecursivelyCreateDir(prefPath_.c_str());
+		paths::SetPrefPath(prefPath_);
+		for (const std::string &file : CacheFiles())
+			RemoveFile(StrCat(cacheDirectory(), file).c_str());
+		GetOptions().StartUp.spriteCache.SetValue(true);
+	}
+
+	void TearDown() override
+	{
+		GetOptions().StartUp.spriteCache.SetValue(false);
+	}
+
+	[[nodiscard]] std::string cacheDirectory() const
+	{
+		return StrCat(prefPath_, DIRECTORY_SEPARATOR_STR "clx_cache" DIRECTORY_SEPARATOR_STR);
+	}
+
+	[[nodiscard]] std::vector<std::string> CacheFiles() const
+	{
+		return ListFiles(cacheDirectory().c_str());
+	}
+
+	[[nodiscard]] std::string sourcePath() const
+	{
+		return StrCat(prefPath_, DIRECTORY_SEPARATOR_STR "source.mpq");
+	}
+
+	void WriteSource(size_t size) const
+	{
+		FILE *file = std::fopen(sourcePath().c_str(), "wb");
+		ASSERT_NE(file, nullptr);
+		const std::vector<char> data(size);
+		std::fwrite(data.data(), 1, data.size(), file);
+		std::fclose(file);
+	}
+
+	[[nodiscard]] std::string sourceKey() const
+	{
+		const std::optional<std::string> key = GetClxCacheSourceKey(sourcePath());
+		return key ? StrCat(*key, "|0|20|sprite|") : std::string {};
+	}
+
+	/** @brief Changes the last pixel of the only entry, so that it no longer matches its hash. */
+	void CorruptEntry() const
+	{
+		const std::vector<std::string> files = CacheFiles();
+		ASSERT_EQ(files.size(), 1U);
+		FILE *file = std::fopen(StrCat(cacheDirectory(), files[0]).c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		std::fseek(file, -1, SEEK_END);
+		std::fputc(43, file);
+		std::fclose(file);
+	}
+
+	static void Store(const std::string &key, const std::vector<uint8_t> &extra = {})
+	{
+		StoreCachedClx(key, ClxSpriteListOrSheet { SpriteListData.data(), 0 }, extra);
+	}
+
+	std::string prefPath_;
+};
+
+TEST_F(ClxCacheTest, LoadsStoredSprites)
+{
+	Store("archive|1|2|sprite", { 1, 2, 3 });
+
+	std::vector<uint8_t> extra;
+	OptionalOwnedClxSpriteListOrSheet loaded = LoadCachedClx("archive|1|2|sprite", &extra);
+	ASSERT_TRUE(loaded);
+	const ClxSpriteListOrSheet clx { *loaded };
+	ASSERT_FALSE(clx.isSheet());
+	ASSERT_EQ(clx.dataSize(), SpriteListData.size());
+	EXPECT_EQ(std::vector<uint8_t>(clx.data(), clx.data() + clx.dataSize()), SpriteListData);
+	EXPECT_EQ(extra, (std::vector<uint8_t> { 1, 2, 3 }));
+	EXPECT_EQ(clx.list()[0].width(), 2);
+
+	EXPECT_FALSE(LoadCachedClx("archive|1|2|other sprite")) << "Other keys are not cached";
+}
+
+TEST_F(ClxCacheTest, MissesEntriesWithSizesNotMatchingTheFile)
+{
+	Store("archive|1|2|sprite");
+	const std::vector<std::string> files = CacheFiles();
+	ASSERT_EQ(files.size(), 1U);
+	const std::string entryPath = StrCat(cacheDirectory(), files[0]);
+	std::uintmax_t entrySize;
+	ASSERT_TRUE(GetFileSize(entryPath.c_str(), &entrySize));
+
+	// A huge CLX data size must be rejected before anything is allocated.
+	FILE *file = std::fopen(entryPath.c_str(), "r+b");
+	ASSERT_NE(file, nullptr);
+	std::fseek(file, 20, SEEK_SET);
+	const uint8_t hugeSize[] { 0xF0, 0xFF, 0xFF, 0xFF };
+	std::fwrite(hugeSize, 1, sizeof(hugeSize), file);
+	std::fclose(file);
+	EXPECT_FALSE(LoadCachedClx("archive|1|2|sprite"));
+
+	Store("archive|1|2|sprite");
+	ASSERT_TRUE(ResizeFile(entryPath.c_str(), entrySize - 1));
+	EXPECT_FALSE(LoadCachedClx("archive|1|2|sprite")) << "Truncated entries are missed";
+}
+
+TEST_F(ClxCacheTest, PrunesEntriesOfChangedSources)
+{
+	WriteSource(16);
+	const std::optional<std::string> sourceKey = GetClxCacheSourceKey(sourcePath());
+	ASSERT_TRUE(sourceKey);
+	const std::string key = StrCat(*sourceKey, "|0|20|sprite|");
+	Store(key);
+	Store(StrCat(prefPath_, DIRECTORY_SEPARATOR_STR "missing.mpq|16|0|0|20|sprite|"));
+	ASSERT_EQ(CacheFiles().size(), 2U);
+
+	PruneClxCache();
+	EXPECT_EQ(CacheFiles().size(), 1U) << "The entry of the missing archive is removed";
+	EXPECT_TRUE(LoadCachedClx(key));
+
+	WriteSource(32);
+	EXPECT_NE(GetClxCacheSourceKey(sourcePath()), sourceKey);
+	PruneClxCache();
+	EXPECT_TRUE(CacheFiles().empty()) << "The entry of the changed archive is removed";
+}
+
+TEST_F(ClxCacheTest, ReplacesAndPrunesCorruptEntries)
+{
+	WriteSource(16);
+	const std::string key = sourceKey();
+	ASSERT_FALSE(key.empty());
+	Store(key);
+	CorruptEntry();
+	EXPECT_FALSE(LoadCachedClx(key)) << "Entries not matching their hash are missed";
+
+	Store(key);
+	EXPECT_EQ(CacheFiles().size(), 1U);
+	EXPECT_TRUE(LoadCachedClx(key)) << "Storing the sprites again replaces the corrupt entry";
+
+	CorruptEntry();
+	PruneClxCache();
+	EXPECT_TRUE(CacheFiles().empty()) << "Entries not matching their hash are removed";
+}
+
+TEST_F(ClxCacheTest, DoesNotPruneWhileDisabled)
+{
+	Store(StrCat(prefPath_, DIRECTORY_SEPARATOR_STR "missing.mpq|16|0|0|20|sprite|"));
+	GetOptions().StartUp.spriteCache.SetValue(false);
+	PruneClxCache();
+	EXPECT_EQ(CacheFiles().size(), 1U);
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,136 @@
+#include "levels/distance_field.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "level_test.hpp"
+#include "levels/gendung.h"
+#include "levels/walkability.hpp"
+#include "objects.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+constexpr Point Root { 12, 12 };
+constexpr Point Door { 30, 20 };
+constexpr Point Closet { 40, 35 };
+
+/**
+ * @brief Builds a walled area split in two by a wall with a door and an opening, and with a closet that cannot be
+ * entered.
+ */
+void InitLevel()
+{
+	FillLevel(WallPiece);
+	for (int x = 11; x < 49; x++) {
+		for (int y = 11; y < 49; y++)
+			dPiece[x][y] = FloorPiece;
+	}
+	for (int y = 11; y < 49; y++) {
+		if (y != 45)
+			dPiece[30][y] = WallPiece;
+	}
+	for (int x = Closet.x - 2; x <= Closet.x + 2; x++) {
+		for (int y = Closet.y - 2; y <= Closet.y + 2; y++) {
+			const bool isEdge = x == Closet.x - 2 || x == Closet.x + 2 || y == Closet.y - 2 || y == Closet.y + 2;
+			dPiece[x][y] = isEdge ? WallPiece : FloorPiece;
+		}
+	}
+	// Pillars that touch diagonally, so that the step between them cuts corners.
+	dPiece[15][15] = WallPiece;
+	dPiece[16][16] = WallPiece;
+
+	dPiece[Door.x][Door.y] = FloorPiece;
+	dObject[Door.x][Door.y] = 1;
+	Objects[0]._otype = _object_id::OBJ_L1LDOOR;
+	Objects[0]._oSolidFlag = true;
+
+	leveltype = DTYPE_CATHEDRAL;
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	MyPlayer->position.tile = Root;
+	MyPlayer->position.future = Root;
+
+	InvalidateLevelLayout();
+}
+
+using Distances = std::array<std::array<int, MAXDUNY>, MAXDUNX>;
+
+/** @brief Breadth-first search of the walkable tiles, stepping like `FindPlayerPath`: around closed doors and without cutting corners. */
+Distances WalkingDistances(Point root)
+{
+	Distances distances;
+	for (std::array<int, MAXDUNY> &column : distances)
+		column.fill(-1);
+	std::vector<Point> queue { root };
+	distances[root.x][root.y] = 0;
+	for (size_t i = 0; i < queue.size(); i++) {
+		const Point position = queue[i];
+		for (const Displacement &direction : PathDirs) {
+			const Point next = position + direction;
+			if (!InDungeonBounds(next) || distances[next.x][next.y] != -1 || !IsTileWalkable(next) || !CanStep(position, next))
+				continue;
+			distances[next.x][next.y] = distances[position.x][position.y] + 1;
+			queue.push_back(next);
+		}
+	}
+	return distances;
+}
+
+void ExpectLowerBounds()
+{
+	const Player &player = *MyPlayer;
+	const Distances distances = WalkingDistances(Root);
+	int8_t path[MaxPathLengthPlayer];
+	for (int x = 10; x < 50; x++) {
+		for (int y = 10; y < 50; y++) {
+			const Point position { x, y };
+			const uint8_t bound = GetWalkingDistanceLowerBound(player, position);
+			const int distance = distances[x][y];
+			if (distance != -1 && distance <= static_cast<int>(MaxPathLengthPlayer))
+				EXPECT_LE(bound, distance) << "Walking distance to " << position;
+			const int pathLength = FindPlayerPath(player, position, path, MaxPathLengthPlayer);
+			if (pathLength != 0)
+				EXPECT_LE(bound, pathLength) << "Path length to " << position;
+		}
+	}
+}
+
+TEST(DistanceFieldTest, NeverOverestimatesPathLength)
+{
+	InitLevel();
+	ExpectLowerBounds();
+
+	const Distances distances = WalkingDistances(Root);
+	const Point pastDoor = Door + Displacement { 1, 0 };
+	EXPECT_LT(GetWalkingDistanceLowerBound(*MyPlayer, pastDoor), distances[pastDoor.x][pastDoor.y]) << "Closed doors count as open";
+	EXPECT_GT(GetWalkingDistanceLowerBound(*MyPlayer, Closet), MaxPathLengthPlayer) << "The closet cannot be entered";
+
+	Objects[0]._oSolidFlag = false;
+	InvalidateWalkability();
+	ExpectLowerBounds();
+
+	ClearLevel();
+}
+
+TEST(DistanceFieldTest, FollowsPlayer)
+{
+	InitLevel();
+	EXPECT_EQ(GetWalkingDistanceLowerBound(*MyPlayer, Root), 0);
+	EXPECT_EQ(GetWalkingDistanceLowerBound(*MyPlayer, { 20, 12 }), 8);
+
+	MyPlayer->position.future = { 20, 12 };
+	EXPECT_EQ(GetWalkingDistanceLowerBound(*MyPlayer, { 20, 12 }), 0);
+	ExpectLowerBounds();
+
+	ClearLevel();
+}
+
+} // namespace
+} // namespace devilution
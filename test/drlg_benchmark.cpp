@@ -0,0 +1,56 @@
+#include <cstdint>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "drlg_test.hpp"
+#include "levels/gendung.h"
+#include "utils/paths.h"
+
+namespace devilution {
+namespace {
+
+/** @brief Sets up a game in which the dungeons of the given level can be generated, as `TestCreateDungeon` does. */
+void InitLevel(int level)
+{
+	// Set pieces are loaded from the test fixtures.
+	paths::SetPrefPath(paths::BasePath() + "test/fixtures/");
+	LoadModArchives({});
+	TestInitGame(/*fullQuests=*/true, /*originalCathedral=*/true, /*hellfire=*/level > 16);
+
+	currlevel = level;
+	leveltype = GetLevelType(level);
+	pMegaTiles = std::make_unique<MegaTile[]>(GetTileCount(leveltype));
+}
+
+/** @brief Generates the dungeon of a level, with a new seed every time. */
+void BM_CreateDungeon(benchmark::State &state)
+{
+	const auto level = static_cast<int>(state.range(0));
+	InitLevel(level);
+	uint32_t seed = 0;
+	for (auto _ : state) {
+		LevelSeeds[level] = std::nullopt;
+		CreateDungeon(++seed, ENTRY_MAIN);
+		CreateThemeRooms();
+		benchmark::DoNotOptimize(dungeon);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+// Levels of every level type, including the Hellfire nest and crypt.
+BENCHMARK(BM_CreateDungeon)
+    ->ArgName("level")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(5)
+    ->Arg(6)
+    ->Arg(9)
+    ->Arg(10)
+    ->Arg(13)
+    ->Arg(16)
+    ->Arg(17)
+    ->Arg(21);
+
+} // namespace
+} // namespace devilution
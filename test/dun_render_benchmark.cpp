@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 #include <ankerl/unordered_dense.h>
 #include <benchmark/benchmark.h>
@@ -83,6 +84,27 @@ void RunForTileMaskLight(benchmark::State &state, TileType tileType, MaskType ma
 	state.SetItemsProcessed(state.iterations() * tiles.size());
 }
 
+void RunForTileMaskPerPixelLight(benchmark::State &state, TileType tileType, MaskType maskType)
+{
+	const Surface out = Surface(SdlSurface.get());
+	// Light levels change every few pixels, like they do around a light source
+	std::vector<uint8_t> lightmapBuffer(static_cast<size_t>(out.pitch()) * out.h());
+	for (size_t i = 0; i < lightmapBuffer.size(); i++)
+		lightmapBuffer[i] = static_cast<uint8_t>((i % out.pitch()) / 24 % NumLightingLevels);
+	const Lightmap lightmap(out.at(0, 0), lightmapBuffer, out.pitch(), LightTables, FullyLitLightTable, FullyDarkLightTable);
+	const std::span<const LevelCelBlock> tiles = Tiles[tileType];
+	GetOptions().Graphics.perPixelLighting.SetValue(true);
+	for (auto _ : state) {
+		for (const LevelCelBlock &levelCelBlock : tiles) {
+			RenderTile(out, lightmap, Point { 320, 240 }, BmDunCelData.get(), levelCelBlock, maskType, LightTables[0].data());
+			uint8_t color = out[Point { 310, 200 }];
+			benchmark::DoNotOptimize(color);
+		}
+	}
+	GetOptions().Graphics.perPixelLighting.SetValue(false);
+	state.SetItemsProcessed(state.iterations() * tiles.size());
+}
+
 using GetLightTableFn = const uint8_t *();
 
 const uint8_t *FullyLit() { return LightTables[0].data(); }
@@ -96,6 +118,13 @@ void Render(benchmark::State &state)
 	RunForTileMaskLight(state, TileT, MaskT, GetLightTableFnT());
 }
 
+template <TileType TileT, MaskType MaskT>
+void RenderPerPixel(benchmark::State &state)
+{
+	InitOnce();
+	RunForTileMaskPerPixelLight(state, TileT, MaskT);
+}
+
 // Define aliases in order to have shorter benchmark names.
 constexpr auto LeftTriangle = TileType::LeftTriangle;
 constexpr auto RightTriangle = TileType::RightTriangle;
@@ -106,10 +135,11 @@ constexpr auto RightTrapezoid = TileType::RightTrapezoid;
 constexpr auto Transparent = MaskType::Transparent;
 constexpr auto Solid = MaskType::Solid;
 
-#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)      \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);  \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark); \
-	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit);
+#define DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, MASK_TYPE)         \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyLit);     \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, FullyDark);    \
+	BENCHMARK_TEMPLATE(Render, TILE_TYPE, MASK_TYPE, PartiallyLit); \
+	BENCHMARK_TEMPLATE(RenderPerPixel, TILE_TYPE, MASK_TYPE);
 
 #define DEFINE_FOR_TILE_TYPE(TILE_TYPE)             \
 	DEFINE_FOR_TILE_AND_MASK_TYPE(TILE_TYPE, Solid) \
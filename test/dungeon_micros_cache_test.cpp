@@ -0,0 +1,101 @@
+#include "levels/gendung.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/assets.hpp"
+#include "engine/load_file.hpp"
+#include "utils/endian_read.hpp"
+
+namespace devilution {
+namespace {
+
+struct DungeonMicros {
+	std::vector<std::byte> cels;
+	uint_fast8_t microTileLen;
+	std::vector<MICROS> micros;
+};
+
+DungeonMicros CurrentDungeonMicros()
+{
+	const auto *offsets = reinterpret_cast<const uint8_t *>(pDungeonCels.get());
+	const size_t celsSize = LoadLE32(&offsets[4 * (LoadLE32(offsets) + 1)]);
+	return {
+		std::vector<std::byte>(pDungeonCels.get(), pDungeonCels.get() + celsSize),
+		MicroTileLen,
+		std::vector<MICROS>(&DPieceMicros[0], &DPieceMicros[MAXTILES]),
+	};
+}
+
+void ClearDungeonMicros()
+{
+	pDungeonCels = nullptr;
+	MicroTileLen = 0;
+	memset(DPieceMicros, 0, sizeof(DPieceMicros));
+}
+
+/** @brief Sets up the micros of the current level type the way `LoadGameLevel` does when they are not cached. */
+DungeonMicros SetUpDungeonMicros(const char *celPath)
+{
+	ClearDungeonMicros();
+	EXPECT_TRUE(LoadLevelSOLData().has_value());
+	pDungeonCels = LoadFileInMem(celPath);
+	SetDungeonMicros(pDungeonCels, MicroTileLen);
+	return CurrentDungeonMicros();
+}
+
+void ExpectRestored(const DungeonMicros &expected)
+{
+	ClearDungeonMicros();
+	ASSERT_TRUE(RestoreDungeonMicros(pDungeonCels, MicroTileLen));
+	const DungeonMicros restored = CurrentDungeonMicros();
+	EXPECT_EQ(restored.cels, expected.cels);
+	EXPECT_EQ(restored.microTileLen, expected.microTileLen);
+	EXPECT_EQ(memcmp(restored.micros.data(), expected.micros.data(), restored.micros.size() * sizeof(MICROS)), 0);
+}
+
+TEST(DungeonMicrosCacheTest, RestoresMostRecentTilesets)
+{
+	LoadCoreArchives();
+	LoadGameArchives();
+
+	// The tests need spawn.mpq or diabdat.mpq
+	// Please provide them so that the tests can run successfully
+	ASSERT_TRUE(HaveMainData());
+
+	FreeDungeonMicrosCache();
+	leveltype = DTYPE_CATHEDRAL;
+	EXPECT_FALSE(HasCachedDungeonMicros());
+	const DungeonMicros cathedral = SetUpDungeonMicros("levels\\l1data\\l1.cel");
+	EXPECT_TRUE(HasCachedDungeonMicros());
+
+	leveltype = DTYPE_CATACOMBS;
+	EXPECT_FALSE(HasCachedDungeonMicros());
+	EXPECT_FALSE(RestoreDungeonMicros(pDungeonCels, MicroTileLen));
+	const DungeonMicros catacombs = SetUpDungeonMicros("levels\\l2data\\l2.cel");
+
+	leveltype = DTYPE_CATHEDRAL;
+	ExpectRestored(cathedral);
+	leveltype = DTYPE_CATACOMBS;
+	ExpectRestored(catacombs);
+
+	// Restoring the catacombs made the cathedral the least recently used tileset.
+	leveltype = DTYPE_CAVES;
+	SetUpDungeonMicros("levels\\l3data\\l3.cel");
+	leveltype = DTYPE_CATHEDRAL;
+	EXPECT_FALSE(HasCachedDungeonMicros());
+	leveltype = DTYPE_CATACOMBS;
+	ExpectRestored(catacombs);
+
+	FreeDungeonMicrosCache();
+	EXPECT_FALSE(HasCachedDungeonMicros());
+	ClearDungeonMicros();
+}
+
+} // namespace
+} // namespace devilution
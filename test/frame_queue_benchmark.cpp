@@ -0,0 +1,48 @@
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include "dvlnet/frame_queue.h"
+
+namespace devilution {
+namespace net {
+namespace {
+
+/** @brief A stream of frames with packet sizes typical of a multiplayer game. */
+buffer_t MakeStream()
+{
+	constexpr size_t PacketSizes[] = { 16, 24, 40, 96, 250, 512, 1400 };
+	buffer_t stream;
+	for (size_t i = 0; i < 1024; i++) {
+		const buffer_t packet(PacketSizes[i % std::size(PacketSizes)], static_cast<unsigned char>(i));
+		const tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(packet);
+		stream.insert(stream.end(), frame->begin(), frame->end());
+	}
+	return stream;
+}
+
+/** @brief Feeds the stream to the queue in chunks of the given size, reading each frame as soon as it is complete. */
+void BM_ReadFragmentedFrames(benchmark::State &state)
+{
+	const buffer_t stream = MakeStream();
+	const auto chunkSize = static_cast<size_t>(state.range(0));
+	frame_queue queue;
+	for (auto _ : state) {
+		for (size_t i = 0; i < stream.size(); i += chunkSize) {
+			queue.Write({ stream.data() + i, std::min(chunkSize, stream.size() - i) });
+			while (queue.PacketReady().value_or(false)) {
+				const tl::expected<std::span<const unsigned char>, PacketError> packet = queue.ReadPacket();
+				benchmark::DoNotOptimize(packet->data());
+			}
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+
+BENCHMARK(BM_ReadFragmentedFrames)->Arg(7)->Arg(536)->Arg(1460)->Arg(frame_queue::max_frame_size);
+
+} // namespace
+} // namespace net
+} // namespace devilution
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dvlnet/frame_queue.h"
+
+namespace devilution {
+namespace net {
+namespace {
+
+buffer_t MakePacket(size_t size, unsigned char fill)
+{
+	return buffer_t(size, fill);
+}
+
+void WriteInChunks(frame_queue &queue, const buffer_t &data, size_t chunkSize)
+{
+	for (size_t i = 0; i < data.size(); i += chunkSize) {
+		const size_t count = std::min(chunkSize, data.size() - i);
+		queue.Write({ data.data() + i, count });
+	}
+}
+
+std::vector<buffer_t> ReadAllPackets(frame_queue &queue)
+{
+	std::vector<buffer_t> packets;
+	while (true) {
+		const tl::expected<bool, PacketError> ready = queue.PacketReady();
+		EXPECT_TRUE(ready.has_value());
+		if (!ready.has_value() || !*ready)
+			break;
+		const tl::expected<std::span<const unsigned char>, PacketError> packet = queue.ReadPacket();
+		EXPECT_TRUE(packet.has_value());
+		if (!packet.has_value())
+			break;
+		packets.emplace_back(packet->begin(), packet->end());
+	}
+	return packets;
+}
+
+TEST(FrameQueueTest, ReadsWholeFrames)
+{
+	frame_queue queue;
+	const buffer_t packet = MakePacket(100, 7);
+	const tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(packet);
+	ASSERT_TRUE(frame.has_value());
+	ASSERT_EQ(frame->size(), packet.size() + sizeof(framesize_t));
+
+	queue.Write(*frame);
+	const std::vector<buffer_t> packets = ReadAllPackets(queue);
+	ASSERT_EQ(packets.size(), 1U);
+	EXPECT_EQ(packets[0], packet);
+}
+
+TEST(FrameQueueTest, ReassemblesFragmentedFrames)
+{
+	std::vector<buffer_t> expected;
+	buffer_t stream;
+	for (size_t i = 1; i <= 50; i++) {
+		expected.push_back(MakePacket(i * 37, static_cast<unsigned char>(i)));
+		const tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(expected.back());
+		ASSERT_TRUE(frame.has_value());
+		stream.insert(stream.end(), frame->begin(), frame->end());
+	}
+
+	for (const size_t chunkSize : { 1, 3, 64, 1000 }) {
+		frame_queue queue;
+		std::vector<buffer_t> packets;
+		for (size_t i = 0; i < stream.size(); i += chunkSize) {
+			const size_t count = std::min(chunkSize, stream.size() - i);
+			queue.Write({ stream.data() + i, count });
+			for (buffer_t &packet : ReadAllPackets(queue))
+				packets.push_back(std::move(packet));
+		}
+		EXPECT_EQ(packets, expected) << "chunk size " << chunkSize;
+	}
+}
+
+TEST(FrameQueueTest, WaitsForTheRestOfTheFrame)
+{
+	frame_queue queue;
+	const tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(MakePacket(10, 1));
+	ASSERT_TRUE(frame.has_value());
+
+	WriteInChunks(queue, buffer_t(frame->begin(), frame->end() - 1), 2);
+	EXPECT_TRUE(ReadAllPackets(queue).empty());
+	EXPECT_FALSE(queue.ReadPacket().has_value());
+
+	queue.Write({ &frame->back(), 1 });
+	EXPECT_EQ(ReadAllPackets(queue).size(), 1U);
+}
+
+TEST(FrameQueueTest, RejectsEmptyFrames)
+{
+	frame_queue queue;
+	const unsigned char emptyFrame[] = { 0, 0, 0, 0 };
+	queue.Write(emptyFrame);
+	EXPECT_FALSE(queue.PacketReady().has_value());
+}
+
+TEST(FrameQueueTest, RejectsOversizedPackets)
+{
+	EXPECT_FALSE(frame_queue::MakeFrame(MakePacket(frame_queue::max_frame_size + 1, 0)).has_value());
+}
+
+} // namespace
+} // namespace net
+} // namespace devilution
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/random.hpp"
+#include "game_mode.hpp"
+#include "itemdat.h"
+#include "items.h"
+#include "player.h"
+#include "spells.h"
+
+namespace devilution {
+namespace {
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		LoadItemData();
+		LoadSpellData();
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+		*MyPlayer = {};
+		gbIsSpawn = false;
+		gbIsMultiplayer = false;
+		return true;
+	}();
+}
+
+std::vector<_item_indexes> DropableBaseItems()
+{
+	std::vector<_item_indexes> result;
+	for (size_t i = 0; i < AllItemsList.size(); i++) {
+		if (IsItemAvailable(static_cast<int>(i)) && AllItemsList[i].dropRate > 0)
+			result.push_back(static_cast<_item_indexes>(i));
+	}
+	return result;
+}
+
+/** @brief Generates every dropable base item at the given level, as magic items where possible. */
+void BM_SetupAllItems(benchmark::State &state)
+{
+	InitOnce();
+	const int lvl = static_cast<int>(state.range(0));
+	const std::vector<_item_indexes> baseItems = DropableBaseItems();
+	uint32_t seed = 0;
+	for (auto _ : state) {
+		for (const _item_indexes idx : baseItems) {
+			Item item = {};
+			SetupAllItems(*MyPlayer, item, idx, ++seed, lvl, /*uper=*/1, /*onlygood=*/true, /*pregen=*/false, /*uidOffset=*/0, /*forceNotUnique=*/true);
+			benchmark::DoNotOptimize(item._iPrePower);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(baseItems.size()));
+}
+
+BENCHMARK(BM_SetupAllItems)->Arg(1)->Arg(15)->Arg(30);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,60 @@
+/**
+ * @file level_test.hpp
+ *
+ * Helpers for tests that build a level tile by tile.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "levels/gendung.h"
+#include "levels/tile_properties.hpp"
+#include "levels/walkability.hpp"
+
+namespace devilution {
+
+constexpr uint16_t FloorPiece = 0;
+constexpr uint16_t WallPiece = 1;
+
+/**
+ * @brief Fills the whole level with `piece` and removes all players, monsters and objects from it.
+ *
+ * The caller is expected to invalidate the level layout once it is done changing the level.
+ */
+inline void FillLevel(uint16_t piece)
+{
+	SOLData[FloorPiece] = TileProperties::None;
+	SOLData[WallPiece] = TileProperties::Solid;
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			dPiece[x][y] = piece;
+			dTransVal[x][y] = 0;
+			dPlayer[x][y] = 0;
+			dMonster[x][y] = 0;
+			dObject[x][y] = 0;
+		}
+	}
+}
+
+/** @brief Builds a single corridor winding back and forth across the level, with `laneCount` lanes joined at alternating ends. */
+inline void InitWindingCorridor(int laneCount)
+{
+	FillLevel(WallPiece);
+	for (int lane = 0; lane < laneCount; lane++) {
+		const int y = 2 + 2 * lane;
+		for (int x = 1; x < MAXDUNX - 1; x++)
+			dPiece[x][y] = FloorPiece;
+		if (lane + 1 < laneCount)
+			dPiece[lane % 2 == 0 ? MAXDUNX - 2 : 1][y + 1] = FloorPiece;
+	}
+	InvalidateLevelLayout();
+}
+
+/** @brief Leaves an empty floor behind for the next test. */
+inline void ClearLevel()
+{
+	FillLevel(FloorPiece);
+	InvalidateLevelLayout();
+}
+
+} // namespace devilution
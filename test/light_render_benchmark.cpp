@@ -1,6 +1,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdio>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -15,12 +16,10 @@
 namespace devilution {
 namespace {
 
-void BM_BuildLightmap(benchmark::State &state)
+void LoadLightData(uint8_t dLight[MAXDUNX][MAXDUNY])
 {
 	const std::string benchmarkDataPath = paths::BasePath() + "test/fixtures/light_render_benchmark/dLight.dmp";
 	FILE *lightFile = std::fopen(benchmarkDataPath.c_str(), "rb");
-	uint8_t dLight[MAXDUNX][MAXDUNY];
-	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
 	if (lightFile != nullptr) {
 		if (std::fread(&dLight[0][0], sizeof(uint8_t) * MAXDUNX * MAXDUNY, 1, lightFile) != 1) {
 			std::perror("Failed to read dLight.dmp");
@@ -28,6 +27,13 @@ void BM_BuildLightmap(benchmark::State &state)
 		}
 		std::fclose(lightFile);
 	}
+}
+
+void BM_BuildLightmap(benchmark::State &state)
+{
+	uint8_t dLight[MAXDUNX][MAXDUNY];
+	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
+	LoadLightData(dLight);
 
 	const SDLSurfaceUniquePtr sdl_surface = SDLWrap::CreateRGBSurfaceWithFormat(
 	    /*flags=*/0, /*width=*/640, /*height=*/480, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
@@ -60,7 +66,45 @@ void BM_BuildLightmap(benchmark::State &state)
 	state.SetItemsProcessed(state.iterations() * rows * columns);
 }
 
+void BM_AdjustColors(benchmark::State &state)
+{
+	uint8_t dLight[MAXDUNX][MAXDUNY];
+	std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels> lightTables;
+	LoadLightData(dLight);
+	for (size_t i = 0; i < lightTables.size(); i++) {
+		for (size_t j = 0; j < LightTableSize; j++)
+			lightTables[i][j] = static_cast<uint8_t>(i * 16 + j);
+	}
+
+	constexpr int ViewportWidth = 640;
+	constexpr int ViewportHeight = 352;
+	std::vector<uint8_t> src(ViewportWidth * ViewportHeight);
+	for (size_t i = 0; i < src.size(); i++)
+		src[i] = static_cast<uint8_t>(i * 7);
+	std::vector<uint8_t> out(ViewportWidth * ViewportHeight);
+
+	const Lightmap lightmap = Lightmap::build(/*perPixelLighting=*/true,
+	    /*tilePosition=*/ { 48, 44 }, /*targetBufferPosition=*/ { 0, -17 },
+	    ViewportWidth, ViewportHeight, /*rows=*/25, /*columns=*/10,
+	    out.data(), ViewportWidth, lightTables, lightTables[0].data(), lightTables.back().data(),
+	    dLight, /*microTileLen=*/10);
+
+	// Dungeon tiles are drawn in rows of up to 32 pixels
+	const auto rowLength = static_cast<unsigned>(state.range(0));
+	for (auto _ : state) {
+		for (int y = 0; y < ViewportHeight; y++) {
+			for (int x = 0; x + static_cast<int>(rowLength) <= ViewportWidth; x += rowLength) {
+				uint8_t *dst = &out[y * ViewportWidth + x];
+				lightmap.adjustColors(&src[y * ViewportWidth + x], lightmap.getLightingAt(dst), rowLength, dst);
+			}
+		}
+		benchmark::DoNotOptimize(out.data());
+	}
+	state.SetBytesProcessed(state.iterations() * ViewportWidth * ViewportHeight);
+}
+
 BENCHMARK(BM_BuildLightmap);
+BENCHMARK(BM_AdjustColors)->Arg(32)->Arg(640);
 
 } // namespace
 } // namespace devilution
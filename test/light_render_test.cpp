@@ -0,0 +1,84 @@
+#include "engine/render/light_render.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/lighting_defs.hpp"
+
+namespace devilution {
+namespace {
+
+using LightTables = std::array<std::array<uint8_t, LightTableSize>, NumLightingLevels>;
+
+LightTables MakeLightTables()
+{
+	std::mt19937 rng(1);
+	LightTables lightTables;
+	for (auto &lightTable : lightTables) {
+		for (uint8_t &color : lightTable)
+			color = static_cast<uint8_t>(rng());
+	}
+	return lightTables;
+}
+
+/** @brief Checks `adjustColors` against `adjustColor` for a row starting at `offset` bytes into the buffers. */
+void ExpectSameAsAdjustColor(const Lightmap &lightmap, unsigned length, unsigned offset, std::mt19937 &rng)
+{
+	std::vector<uint8_t> src(offset + length);
+	std::vector<uint8_t> light(offset + length);
+	for (unsigned i = 0; i < offset + length; i++) {
+		src[i] = static_cast<uint8_t>(rng());
+		light[i] = static_cast<uint8_t>(rng() % NumLightingLevels);
+	}
+	// A sentinel after the row catches writes past its end.
+	std::vector<uint8_t> out(offset + length + 1, 0xCD);
+	lightmap.adjustColors(src.data() + offset, light.data() + offset, length, out.data() + offset);
+
+	for (unsigned i = offset; i < offset + length; i++) {
+		ASSERT_EQ(out[i], lightmap.adjustColor(src[i], light[i])) << "length " << length << ", offset " << offset << ", pixel " << i - offset;
+	}
+	EXPECT_EQ(out[offset + length], 0xCD) << "length " << length << ", offset " << offset;
+}
+
+TEST(LightRenderTest, AdjustColorsMatchesAdjustColor)
+{
+	const LightTables lightTables = MakeLightTables();
+	const uint8_t lightmapBuffer[1] {};
+	const Lightmap lightmap(nullptr, lightmapBuffer, 1, lightTables, lightTables[0].data(), lightTables.back().data());
+
+	std::mt19937 rng(2);
+	for (unsigned length = 0; length <= 67; length++) {
+		for (unsigned offset = 0; offset < 8; offset++)
+			ExpectSameAsAdjustColor(lightmap, length, offset, rng);
+	}
+}
+
+TEST(LightRenderTest, AdjustColorsCoversEveryColorAtEveryLightLevel)
+{
+	const LightTables lightTables = MakeLightTables();
+	const uint8_t lightmapBuffer[1] {};
+	const Lightmap lightmap(nullptr, lightmapBuffer, 1, lightTables, lightTables[0].data(), lightTables.back().data());
+
+	// One unaligned row with every (light level, color) pair, with a length that is not a multiple of 8.
+	constexpr unsigned Length = NumLightingLevels * LightTableSize + 5;
+	std::vector<uint8_t> src(Length + 3);
+	std::vector<uint8_t> light(Length + 3);
+	for (unsigned i = 0; i < Length; i++) {
+		src[i + 3] = static_cast<uint8_t>(i % LightTableSize);
+		light[i + 3] = static_cast<uint8_t>(i / LightTableSize % NumLightingLevels);
+	}
+	std::vector<uint8_t> out(Length + 3);
+	lightmap.adjustColors(src.data() + 3, light.data() + 3, Length, out.data() + 3);
+
+	for (unsigned i = 3; i < Length + 3; i++) {
+		ASSERT_EQ(out[i], lightTables[light[i]][src[i]]) << "light level " << static_cast<int>(light[i]) << ", color " << static_cast<int>(src[i]);
+	}
+}
+
+} // namespace
+} // namespace devilution
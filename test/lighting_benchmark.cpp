@@ -0,0 +1,75 @@
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/lighting_defs.hpp"
+#include "engine/point.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+
+namespace devilution {
+namespace {
+
+constexpr Point MovingLightStart { 20, 20 };
+
+/**
+ * @brief Sets up a dark Hell level with every light slot taken, similar to a busy fight with lit monsters and missiles.
+ */
+int InitCrowdedLevel()
+{
+	leveltype = DTYPE_HELL;
+	MakeLightTable();
+	InitLighting();
+	memset(dPreLight, LightsMax, sizeof(dPreLight));
+	memcpy(dLight, dPreLight, sizeof(dLight));
+
+	const int movingLight = AddLight(MovingLightStart, 3);
+	for (int i = 1; i < MAXLIGHTS; i++) {
+		const Point position { 16 + (i % 8) * 10, 16 + (i / 8) * 10 };
+		AddLight(position, static_cast<uint8_t>(3 + i % 6));
+	}
+	UpdateLighting = true;
+	ProcessLightList();
+	return movingLight;
+}
+
+void RunMovingLight(benchmark::State &state, bool fullRelight)
+{
+	const int movingLight = InitCrowdedLevel();
+	bool forward = true;
+	for (auto _ : state) {
+		ChangeLightXY(movingLight, MovingLightStart + Displacement { forward ? 1 : 0, 0 });
+		forward = !forward;
+		if (fullRelight)
+			UpdateLighting = true;
+		ProcessLightList();
+		benchmark::DoNotOptimize(dLight[MovingLightStart.x][MovingLightStart.y]);
+	}
+}
+
+void BM_FullRelight(benchmark::State &state)
+{
+	RunMovingLight(state, /*fullRelight=*/true);
+}
+
+void BM_IncrementalRelight(benchmark::State &state)
+{
+	RunMovingLight(state, /*fullRelight=*/false);
+}
+
+void BM_DoLighting(benchmark::State &state)
+{
+	InitCrowdedLevel();
+	const auto radius = static_cast<uint8_t>(state.range(0));
+	for (auto _ : state) {
+		DoLighting(MovingLightStart, radius, { 3, -2 });
+		benchmark::DoNotOptimize(dLight[MovingLightStart.x][MovingLightStart.y]);
+	}
+}
+
+BENCHMARK(BM_FullRelight);
+BENCHMARK(BM_IncrementalRelight);
+BENCHMARK(BM_DoLighting)->Arg(3)->Arg(8)->Arg(15);
+
+} // namespace
+} // namespace devilution
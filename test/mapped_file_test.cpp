@@ -0,0 +1,97 @@
+#include "mpq/mpq_sdl_rwops.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+#include <SDL.h>
+#include <gtest/gtest.h>
+
+#include "utils/mapped_file.hpp"
+
+using namespace devilution;
+
+namespace {
+
+constexpr char Contents[] = "0123456789abcdef";
+
+std::string GetTmpPathName()
+{
+	const auto *current_test = ::testing::UnitTest::GetInstance()->current_test_info();
+	std::string result = "Test_";
+	result.append(current_test->test_case_name());
+	result += '_';
+	result.append(current_test->name());
+	result.append(".tmp");
+	return result;
+}
+
+std::shared_ptr<const MappedFile> MapTestFile()
+{
+	const std::string path = GetTmpPathName();
+	FILE *file = std::fopen(path.c_str(), "wb");
+	if (file == nullptr)
+		return nullptr;
+	std::fwrite(Contents, 1, sizeof(Contents) - 1, file);
+	std::fclose(file);
+	std::optional<MappedFile> mapped = MappedFile::Open(path.c_str());
+	if (!mapped)
+		return nullptr;
+	return std::make_shared<const MappedFile>(std::move(*mapped));
+}
+
+std::string ReadAll(SDL_RWops *handle, size_t size)
+{
+	std::string result(size, '\0');
+	result.resize(SDL_RWread(handle, result.data(), 1, size));
+	return result;
+}
+
+TEST(MappedFile, MapsWholeFile)
+{
+	const std::shared_ptr<const MappedFile> mapping = MapTestFile();
+	if (mapping == nullptr)
+		GTEST_SKIP() << "Memory mapping is not supported";
+	const std::span<const std::byte> data = mapping->data();
+	ASSERT_EQ(data.size(), sizeof(Contents) - 1);
+	EXPECT_EQ(std::string(reinterpret_cast<const char *>(data.data()), data.size()), Contents);
+}
+
+TEST(MappedFile, ReadsViewAfterMappingIsReleased)
+{
+	std::shared_ptr<const MappedFile> mapping = MapTestFile();
+	if (mapping == nullptr)
+		GTEST_SKIP() << "Memory mapping is not supported";
+	const std::span<const std::byte> view = mapping->data().subspan(4, 8);
+	SDL_RWops *handle = SDL_RWops_FromMappedView(mapping, view);
+	ASSERT_NE(handle, nullptr);
+	mapping = nullptr;
+
+	EXPECT_EQ(ReadAll(handle, 3), "456");
+	EXPECT_EQ(ReadAll(handle, 100), "789ab") << "Reads stop at the end of the view";
+	EXPECT_EQ(ReadAll(handle, 1), "");
+	SDL_RWclose(handle);
+}
+
+TEST(MappedFile, SeeksWithinView)
+{
+	const std::shared_ptr<const MappedFile> mapping = MapTestFile();
+	if (mapping == nullptr)
+		GTEST_SKIP() << "Memory mapping is not supported";
+	SDL_RWops *handle = SDL_RWops_FromMappedView(mapping, mapping->data().subspan(4, 8));
+	ASSERT_NE(handle, nullptr);
+
+	EXPECT_EQ(SDL_RWseek(handle, -2, RW_SEEK_END), 6);
+	EXPECT_EQ(ReadAll(handle, 2), "ab");
+	EXPECT_EQ(SDL_RWseek(handle, -4, RW_SEEK_CUR), 4);
+	EXPECT_EQ(ReadAll(handle, 1), "8");
+	EXPECT_EQ(SDL_RWseek(handle, 9, RW_SEEK_SET), -1) << "Seeking past the end of the view fails";
+	EXPECT_EQ(SDL_RWseek(handle, -1, RW_SEEK_SET), -1) << "Seeking before the start of the view fails";
+	EXPECT_EQ(SDL_RWtell(handle), 5);
+	SDL_RWclose(handle);
+}
+
+} // namespace
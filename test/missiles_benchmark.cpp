@@ -0,0 +1,77 @@
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/direction.hpp"
+#include "engine/displacement.hpp"
+#include "engine/point.hpp"
+#include "misdat.h"
+#include "missiles.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+		*MyPlayer = {};
+		LoadMissileData();
+		return true;
+	}();
+}
+
+void AddArrows(size_t count)
+{
+	const Player &player = *MyPlayer;
+	for (size_t i = 0; i < count; i++) {
+		const Point src { 16 + static_cast<int>(i % 64), 16 + static_cast<int>((i / 64) % 64) };
+		AddMissile(src, src + Displacement { 5, 3 }, Direction::South, MissileID::Arrow, TARGET_MONSTERS, player, 0, 0);
+	}
+}
+
+void DeleteAllMissiles()
+{
+	for (Missile &missile : Missiles)
+		missile._miDelFlag = true;
+	ProcessMissiles();
+}
+
+/** @brief A volley of missiles that lives for a single game tick. */
+void BM_SpawnProcessDelete(benchmark::State &state)
+{
+	InitOnce();
+	const auto count = static_cast<size_t>(state.range(0));
+	for (auto _ : state) {
+		AddArrows(count);
+		ProcessMissiles();
+		DeleteAllMissiles();
+		benchmark::DoNotOptimize(Missiles.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** @brief A steady stream of missiles, replacing the ones that expire. */
+void BM_ProcessMissiles(benchmark::State &state)
+{
+	InitOnce();
+	const auto count = static_cast<size_t>(state.range(0));
+	AddArrows(count);
+	for (auto _ : state) {
+		ProcessMissiles();
+		if (Missiles.size() < count)
+			AddArrows(count - Missiles.size());
+		benchmark::DoNotOptimize(Missiles.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	DeleteAllMissiles();
+}
+
+BENCHMARK(BM_SpawnProcessDelete)->Arg(16)->Arg(128)->Arg(512);
+BENCHMARK(BM_ProcessMissiles)->Arg(16)->Arg(128)->Arg(512);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <expected.hpp>
+
+#include "controls/control_mode.hpp"
+#include "controls/plrctrls.h"
+#include "cursor.h"
+#include "engine/assets.hpp"
+#include "engine/direction.hpp"
+#include "engine/point.hpp"
+#include "levels/distance_field.hpp"
+#include "levels/gendung.h"
+#include "levels/walkability.hpp"
+#include "monstdat.h"
+#include "monster.h"
+#include "multi.h"
+#include "player.h"
+#include "utils/log.hpp"
+
+namespace devilution {
+namespace {
+
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		LoadCoreArchives();
+		LoadGameArchives();
+		if (!HaveMainData()) {
+			LogError("This benchmark needs spawn.mpq or diabdat.mpq");
+			exit(1);
+		}
+		LoadMonsterData();
+		Players.resize(1);
+		MyPlayerId = 0;
+		MyPlayer = &Players[MyPlayerId];
+		return true;
+	}();
+}
+
+/** @brief Clears the level and prepares it for zombies, returning the index of their monster type. */
+size_t InitOpenLevel()
+{
+	InitOnce();
+	*MyPlayer = {};
+	gbIsMultiplayer = false;
+	leveltype = DTYPE_CATHEDRAL;
+	currlevel = 1;
+	memset(dPiece, 0, sizeof(dPiece));
+	memset(SOLData, 0, sizeof(SOLData));
+	memset(dTransVal, 0, sizeof(dTransVal));
+	memset(dObject, 0, sizeof(dObject));
+	memset(dMonster, 0, sizeof(dMonster));
+	memset(dPlayer, 0, sizeof(dPlayer));
+	std::fill(&dFlags[0][0], &dFlags[0][0] + MAXDUNX * MAXDUNY, DungeonFlag::Visible | DungeonFlag::Lit);
+	InvalidateDistanceFields();
+	InvalidateWalkability();
+
+	InitLevelMonsters();
+	const tl::expected<size_t, std::string> typeIndex = AddMonsterType(MT_NZOMBIE, PLACE_SCATTER);
+	if (!typeIndex.has_value() || !InitAllMonsterGFX().has_value()) {
+		LogError("Failed to load the monster graphics");
+		exit(1);
+	}
+	return *typeIndex;
+}
+
+/**
+ * @brief Fills an open, fully visible level with `MaxMonsters` monsters packed close together.
+ *
+ * The player is kept off the level, so the monsters look for each other when picking an enemy.
+ */
+void InitPackedLevel(bool berserk)
+{
+	const size_t typeIndex = InitOpenLevel();
+	for (size_t i = 0; i < MaxMonsters; i++) {
+		const Point position { 16 + 2 * static_cast<int>(i % 40), 16 + 2 * static_cast<int>(i / 40) };
+		Monster *monster = AddMonster(position, Direction::South, typeIndex, true);
+		if (berserk)
+			monster->flags |= MFLAG_BERSERK;
+	}
+}
+
+/**
+ * @brief Fills a level of long corridors, joined only at their far end, with `MaxMonsters` monsters chasing the player.
+ *
+ * Most monsters are close to the player but on the other side of a wall, so they cannot reach the player within
+ * `MaxPathLengthMonsters` steps, and keep looking for a path.
+ */
+void InitCorridorLevel()
+{
+	const size_t typeIndex = InitOpenLevel();
+	constexpr uint16_t WallPiece = 1;
+	SOLData[WallPiece] = TileProperties::Solid;
+	for (int x = 10; x < 102; x += 4) {
+		for (int y = 10; y < 100; y++)
+			dPiece[x][y] = WallPiece;
+	}
+
+	Player &player = *MyPlayer;
+	player.plractive = true;
+	player.setLevel(currlevel);
+	player._pRSpell = SpellID::Invalid;
+	player.position.tile = { 52, 21 };
+	player.position.future = player.position.tile;
+	dPlayer[player.position.tile.x][player.position.tile.y] = MyPlayerId + 1;
+
+	for (size_t i = 0; i < MaxMonsters; i++) {
+		const Point position { 12 + 4 * static_cast<int>(i % 23), 14 + 3 * static_cast<int>(i / 23) };
+		Monster *monster = AddMonster(position, Direction::South, typeIndex, true);
+		monster->flags |= MFLAG_SEARCH;
+	}
+}
+
+void BM_SelectEnemies(benchmark::State &state)
+{
+	InitPackedLevel(/*berserk=*/state.range(0) != 0);
+	for (auto _ : state) {
+		for (size_t i = 0; i < ActiveMonsterCount; i++) {
+			Monster &monster = Monsters[ActiveMonsters[i]];
+			M_StartStand(monster, monster.direction);
+		}
+		benchmark::DoNotOptimize(Monsters[0].enemy);
+	}
+}
+
+void BM_ProcessMonsters(benchmark::State &state)
+{
+	InitPackedLevel(/*berserk=*/false);
+	for (auto _ : state) {
+		ProcessMonsters();
+		benchmark::DoNotOptimize(Monsters[0].position.tile);
+	}
+}
+
+void BM_ProcessChasingMonsters(benchmark::State &state)
+{
+	InitCorridorLevel();
+	for (auto _ : state) {
+		InvalidateDistanceFields();
+		InvalidateOccupiedTiles();
+		ProcessMonsters();
+		benchmark::DoNotOptimize(Monsters[0].position.tile);
+	}
+}
+
+/** @brief Picks a target for the gamepad in the middle of the monsters of `BM_ProcessChasingMonsters`. */
+void BM_FindGamepadTarget(benchmark::State &state)
+{
+	InitCorridorLevel();
+	for (int i = 0; i < 20; i++)
+		ProcessMonsters();
+	ControlMode = ControlTypes::Gamepad;
+	for (auto _ : state) {
+		plrctrls_after_check_curs_move();
+		benchmark::DoNotOptimize(pcursmonst);
+	}
+	ControlMode = ControlTypes::None;
+}
+
+BENCHMARK(BM_SelectEnemies)->ArgName("berserk")->Arg(0)->Arg(1);
+BENCHMARK(BM_ProcessMonsters);
+BENCHMARK(BM_ProcessChasingMonsters);
+BENCHMARK(BM_FindGamepadTarget);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,112 @@
+#include "mpq/mpq_block_cache.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace devilution;
+
+namespace {
+
+/** Four blocks of this size fill the cache. */
+constexpr size_t BlockSize = DefaultMpqBlockCacheCapacity / 4;
+
+MpqBlockKey Key(uint32_t blockNumber)
+{
+	return { /*archiveId=*/1, /*fileNumber=*/2, blockNumber };
+}
+
+std::vector<uint8_t> Block(uint8_t value, size_t size = BlockSize)
+{
+	return std::vector<uint8_t>(size, value);
+}
+
+bool IsCached(uint32_t blockNumber, uint8_t value)
+{
+	std::vector<uint8_t> out(BlockSize);
+	return ReadCachedMpqBlock(Key(blockNumber), out.data(), out.size()) && out == Block(value);
+}
+
+TEST(MpqBlockCache, ReadsCachedBlocks)
+{
+	ClearMpqBlockCache();
+	CacheMpqBlock(Key(0), Block(10).data(), BlockSize);
+
+	EXPECT_TRUE(IsCached(0, 10));
+	EXPECT_FALSE(IsCached(1, 10)) << "Blocks that were not cached are missed";
+	std::vector<uint8_t> out(BlockSize / 2);
+	EXPECT_FALSE(ReadCachedMpqBlock(Key(0), out.data(), out.size())) << "A read of a different size is missed";
+
+	ClearMpqBlockCache();
+	EXPECT_FALSE(IsCached(0, 10));
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, 0U);
+}
+
+TEST(MpqBlockCache, EvictsLeastRecentlyUsedBlocks)
+{
+	ClearMpqBlockCache();
+	for (uint32_t i = 0; i < 4; i++)
+		CacheMpqBlock(Key(i), Block(static_cast<uint8_t>(i)).data(), BlockSize);
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, DefaultMpqBlockCacheCapacity);
+
+	// Reading block 0 makes block 1 the least recently used one.
+	EXPECT_TRUE(IsCached(0, 0));
+	const size_t evictions = GetMpqBlockCacheStats().evictions;
+	CacheMpqBlock(Key(4), Block(4).data(), BlockSize);
+
+	EXPECT_EQ(GetMpqBlockCacheStats().evictions, evictions + 1);
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, DefaultMpqBlockCacheCapacity);
+	EXPECT_FALSE(IsCached(1, 1));
+	EXPECT_TRUE(IsCached(0, 0));
+	EXPECT_TRUE(IsCached(2, 2));
+	EXPECT_TRUE(IsCached(3, 3));
+	EXPECT_TRUE(IsCached(4, 4));
+	ClearMpqBlockCache();
+}
+
+TEST(MpqBlockCache, DoesNotCacheBlocksLargerThanCapacity)
+{
+	ClearMpqBlockCache();
+	CacheMpqBlock(Key(0), Block(10).data(), BlockSize);
+	const std::vector<uint8_t> large = Block(20, DefaultMpqBlockCacheCapacity + 1);
+	CacheMpqBlock(Key(1), large.data(), large.size());
+
+	std::vector<uint8_t> out(large.size());
+	EXPECT_FALSE(ReadCachedMpqBlock(Key(1), out.data(), out.size()));
+	EXPECT_TRUE(IsCached(0, 10)) << "Other blocks are not evicted for a block that cannot fit";
+	ClearMpqBlockCache();
+}
+
+TEST(MpqBlockCache, EvictsBlocksBeyondNewCapacity)
+{
+	ClearMpqBlockCache();
+	for (uint32_t i = 0; i < 4; i++)
+		CacheMpqBlock(Key(i), Block(static_cast<uint8_t>(i)).data(), BlockSize);
+
+	// Reading block 0 makes blocks 1 and 2 the least recently used ones.
+	EXPECT_TRUE(IsCached(0, 0));
+	SetMpqBlockCacheCapacity(2 * BlockSize);
+	EXPECT_EQ(GetMpqBlockCacheStats().capacityBytes, 2 * BlockSize);
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, 2 * BlockSize);
+	EXPECT_FALSE(IsCached(1, 1));
+	EXPECT_FALSE(IsCached(2, 2));
+	EXPECT_TRUE(IsCached(3, 3));
+	EXPECT_TRUE(IsCached(0, 0));
+
+	// New blocks evict down to the new limit too.
+	CacheMpqBlock(Key(4), Block(4).data(), BlockSize);
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, 2 * BlockSize);
+	EXPECT_FALSE(IsCached(3, 3));
+	EXPECT_TRUE(IsCached(4, 4));
+
+	SetMpqBlockCacheCapacity(0);
+	EXPECT_EQ(GetMpqBlockCacheStats().sizeBytes, 0U);
+	CacheMpqBlock(Key(5), Block(5).data(), BlockSize);
+	EXPECT_FALSE(IsCached(5, 5)) << "A capacity of 0 disables the cache";
+
+	SetMpqBlockCacheCapacity(DefaultMpqBlockCacheCapacity);
+	ClearMpqBlockCache();
+}
+
+} // namespace
@@ -0,0 +1,91 @@
+#include "mpq/mpq_reader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+#include "mpq/mpq_writer.hpp"
+
+using namespace devilution;
+
+namespace {
+
+std::string GetTmpPathName()
+{
+	const auto *current_test = ::testing::UnitTest::GetInstance()->current_test_info();
+	std::string result = "Test_";
+	result.append(current_test->test_case_name());
+	result += '_';
+	result.append(current_test->name());
+	result.append(".mpq");
+	return result;
+}
+
+void WriteTestArchive(const std::string &path)
+{
+	std::remove(path.c_str());
+	MpqWriter writer { path };
+	const std::byte data[16] {};
+	ASSERT_TRUE(writer.WriteFile("test.bin", data, sizeof(data)));
+}
+
+/** @brief Counts the file descriptors of this process that refer to the file at `path`. */
+int CountOpenHandles(const std::string &path)
+{
+	std::error_code ec;
+	const std::filesystem::path target = std::filesystem::canonical(path, ec);
+	int count = 0;
+	for (const auto &entry : std::filesystem::directory_iterator("/proc/self/fd", ec)) {
+		std::error_code linkError;
+		if (std::filesystem::read_symlink(entry.path(), linkError) == target)
+			++count;
+	}
+	return count;
+}
+
+TEST(MpqReader, ClosesArchiveFileOnceArchiveAndClonesAreDestroyed)
+{
+#ifndef __linux__
+	GTEST_SKIP() << "Open files are only counted on Linux";
+#endif
+	const std::string path = GetTmpPathName();
+	WriteTestArchive(path);
+	const int handlesBefore = CountOpenHandles(path);
+
+	std::weak_ptr<const MappedFile> mapping;
+	{
+		int32_t error;
+		std::optional<MpqArchive> archive = MpqArchive::Open(path.c_str(), error);
+		ASSERT_TRUE(archive.has_value());
+		mapping = archive->GetMappedFile();
+		{
+			const PooledMpqArchive first = archive->BorrowClone(error);
+			ASSERT_EQ(error, 0);
+			const PooledMpqArchive second = archive->BorrowClone(error);
+			ASSERT_EQ(error, 0);
+			EXPECT_NE(first.get(), second.get());
+		}
+		const int handlesWithIdleClones = CountOpenHandles(path);
+		EXPECT_GT(handlesWithIdleClones, handlesBefore);
+
+		const PooledMpqArchive borrowed = archive->BorrowClone(error);
+		ASSERT_EQ(error, 0);
+		EXPECT_EQ(CountOpenHandles(path), handlesWithIdleClones) << "An idle clone is reused";
+
+		archive = std::nullopt;
+		EXPECT_TRUE(borrowed.get()->HasFile("test.bin")) << "A borrowed clone outlives the archive";
+	}
+
+	EXPECT_EQ(CountOpenHandles(path), handlesBefore);
+	EXPECT_TRUE(mapping.expired());
+	std::remove(path.c_str());
+}
+
+} // namespace
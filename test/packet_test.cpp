@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "dvlnet/frame_queue.h"
+#include "dvlnet/packet.h"
+
+namespace devilution {
+namespace net {
+namespace {
+
+const buffer_t MessageData = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+std::unique_ptr<packet> SendAndReceive(packet_factory &factory, frame_queue &queue, packet &pkt)
+{
+	tl::expected<buffer_t, PacketError> frame = frame_queue::MakeFrame(pkt.Data());
+	EXPECT_TRUE(frame.has_value());
+	queue.Write(*frame);
+	ReleasePacketBuffer(*std::move(frame));
+
+	EXPECT_TRUE(queue.PacketReady().value_or(false));
+	const tl::expected<std::span<const unsigned char>, PacketError> data = queue.ReadPacket();
+	EXPECT_TRUE(data.has_value());
+	tl::expected<std::unique_ptr<packet>, PacketError> received = factory.make_packet(*data);
+	EXPECT_TRUE(received.has_value());
+	return received.has_value() ? *std::move(received) : nullptr;
+}
+
+/** @brief One game tick of a 4-player game: every player sends a turn and a message. */
+void PlayTick(packet_factory &factory, frame_queue &queue, int32_t value)
+{
+	for (plr_t player = 0; player < 4; player++) {
+		const turn_t turn { static_cast<seq_t>(value), value };
+		tl::expected<std::unique_ptr<packet>, PacketError> turnPacket = factory.make_packet<PT_TURN>(player, PLR_BROADCAST, turn);
+		ASSERT_TRUE(turnPacket.has_value());
+		const std::unique_ptr<packet> receivedTurn = SendAndReceive(factory, queue, **turnPacket);
+		ASSERT_NE(receivedTurn, nullptr);
+		EXPECT_EQ(receivedTurn->Source(), player);
+		EXPECT_EQ(receivedTurn->Turn()->Value, value);
+
+		buffer_t message = AcquirePacketBuffer();
+		message.assign(MessageData.begin(), MessageData.end());
+		tl::expected<std::unique_ptr<packet>, PacketError> messagePacket = factory.make_packet<PT_MESSAGE>(player, PLR_BROADCAST, std::move(message));
+		ASSERT_TRUE(messagePacket.has_value());
+		const std::unique_ptr<packet> receivedMessage = SendAndReceive(factory, queue, **messagePacket);
+		ASSERT_NE(receivedMessage, nullptr);
+		EXPECT_EQ(**receivedMessage->Message(), MessageData);
+	}
+}
+
+TEST(PacketTest, RoundTripsTurnsAndMessages)
+{
+	packet_factory factory("password");
+	frame_queue queue;
+	PlayTick(factory, queue, 42);
+}
+
+TEST(PacketTest, RejectsTamperedPackets)
+{
+	packet_factory factory("password");
+	const turn_t turn { 1, 1234 };
+	tl::expected<std::unique_ptr<packet>, PacketError> pkt = factory.make_packet<PT_TURN>(plr_t { 0 }, PLR_BROADCAST, turn);
+	ASSERT_TRUE(pkt.has_value());
+	buffer_t data = (*pkt)->Data();
+	data.back() ^= 1;
+#ifdef PACKET_ENCRYPTION
+	EXPECT_FALSE(factory.make_packet(std::move(data)).has_value());
+#else
+	EXPECT_TRUE(factory.make_packet(std::move(data)).has_value());
+#endif
+}
+
+TEST(PacketTest, SteadyTrafficDoesNotAllocate)
+{
+	packet_factory factory("password");
+	frame_queue queue;
+	PlayTick(factory, queue, 0);
+
+	const PacketPoolStats before = GetPacketPoolStats();
+	for (int32_t tick = 1; tick <= 1000; tick++)
+		PlayTick(factory, queue, tick);
+	const PacketPoolStats after = GetPacketPoolStats();
+
+	EXPECT_EQ(after.packetAllocations, before.packetAllocations);
+	EXPECT_EQ(after.bufferAllocations, before.bufferAllocations);
+	EXPECT_EQ(after.bufferRegrowths, before.bufferRegrowths);
+}
+
+TEST(PacketTest, CountsRegrowthsOfLargeMessages)
+{
+	packet_factory factory("password");
+	frame_queue queue;
+	const PacketPoolStats before = GetPacketPoolStats();
+
+	const buffer_t largeMessage(4000, 42);
+	tl::expected<std::unique_ptr<packet>, PacketError> pkt = factory.make_packet<PT_MESSAGE>(plr_t { 0 }, PLR_BROADCAST, largeMessage);
+	ASSERT_TRUE(pkt.has_value());
+	const std::unique_ptr<packet> received = SendAndReceive(factory, queue, **pkt);
+	ASSERT_NE(received, nullptr);
+	EXPECT_EQ(**received->Message(), largeMessage);
+
+	EXPECT_GT(GetPacketPoolStats().bufferRegrowths, before.bufferRegrowths);
+}
+
+TEST(PacketTest, CountsQueueAllocations)
+{
+	const PacketPoolStats before = GetPacketPoolStats();
+	PacketQueue<turn_t> queue;
+	queue.push_back({ 1, 1234 });
+	EXPECT_GT(GetPacketPoolStats().queueAllocations, before.queueAllocations);
+}
+
+} // namespace
+} // namespace net
+} // namespace devilution
@@ -0,0 +1,120 @@
+#include "engine/render/partial_redraw.hpp"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/rectangle.hpp"
+#include "engine/surface.hpp"
+
+namespace devilution {
+namespace {
+
+const Rectangle Bounds { { 0, 0 }, { 640, 352 } };
+
+bool Overlap(const Rectangle &a, const Rectangle &b)
+{
+	return !IsDamagedAreaEmpty(ClipDamagedArea(a, b));
+}
+
+bool Covers(const DamagedAreaList &areas, Point point)
+{
+	for (const Rectangle &area : areas) {
+		if (area.contains(point))
+			return true;
+	}
+	return false;
+}
+
+TEST(PartialRedrawTest, DamagedAreasAreClippedToBounds)
+{
+	DamagedAreaList areas;
+	AddDamagedArea(areas, { { -10, -20 }, { 30, 40 } }, Bounds);
+	AddDamagedArea(areas, { { 700, 0 }, { 10, 10 } }, Bounds);
+	AddDamagedArea(areas, { { 100, 100 }, { 0, 10 } }, Bounds);
+
+	ASSERT_EQ(areas.size(), 1U);
+	EXPECT_EQ(areas[0].position, Point(0, 0));
+	EXPECT_EQ(areas[0].size, Size(20, 20));
+}
+
+TEST(PartialRedrawTest, OverlappingDamagedAreasAreMerged)
+{
+	DamagedAreaList areas;
+	AddDamagedArea(areas, { { 0, 0 }, { 10, 10 } }, Bounds);
+	AddDamagedArea(areas, { { 100, 0 }, { 10, 10 } }, Bounds);
+	AddDamagedArea(areas, { { 10, 0 }, { 10, 10 } }, Bounds);
+	ASSERT_EQ(areas.size(), 3U) << "Touching areas do not overlap";
+
+	// The first of these overlaps two of the areas, and the merged area then grows into the remaining one
+	AddDamagedArea(areas, { { 5, 5 }, { 10, 100 } }, Bounds);
+	AddDamagedArea(areas, { { 15, 95 }, { 90, 10 } }, Bounds);
+	ASSERT_EQ(areas.size(), 1U);
+	EXPECT_EQ(areas[0].position, Point(0, 0));
+	EXPECT_EQ(areas[0].size, Size(110, 105));
+}
+
+TEST(PartialRedrawTest, DamagedAreasCoverEveryDamagedPixelOnce)
+{
+	std::mt19937 rng(1);
+	for (int run = 0; run < 200; run++) {
+		DamagedAreaList areas;
+		std::vector<Rectangle> added;
+		const int count = static_cast<int>(rng() % (2 * MaxDamagedAreas));
+		for (int i = 0; i < count; i++) {
+			const Rectangle area { { static_cast<int>(rng() % 700) - 30, static_cast<int>(rng() % 400) - 30 },
+				{ static_cast<int>(rng() % 80), static_cast<int>(rng() % 80) } };
+			added.push_back(area);
+			AddDamagedArea(areas, area, Bounds);
+		}
+
+		ASSERT_LE(areas.size(), MaxDamagedAreas);
+		for (size_t i = 0; i < areas.size(); i++) {
+			EXPECT_FALSE(IsDamagedAreaEmpty(areas[i]));
+			EXPECT_EQ(ClipDamagedArea(areas[i], Bounds).size, areas[i].size) << "Areas stay within the bounds";
+			for (size_t j = i + 1; j < areas.size(); j++)
+				EXPECT_FALSE(Overlap(areas[i], areas[j])) << "No pixel is redrawn twice";
+		}
+		for (const Rectangle &area : added) {
+			const Rectangle clipped = ClipDamagedArea(area, Bounds);
+			if (IsDamagedAreaEmpty(clipped))
+				continue;
+			EXPECT_TRUE(Covers(areas, clipped.position));
+			EXPECT_TRUE(Covers(areas, clipped.position + Displacement { clipped.size.width - 1, clipped.size.height - 1 }));
+		}
+	}
+}
+
+std::vector<std::pair<int, int>> ChangedRowBands(const Surface &current, const Surface &presented, int height)
+{
+	std::vector<std::pair<int, int>> bands;
+	ForEachChangedRowBand(current, presented, height, [&bands](int top, int bottom) {
+		bands.emplace_back(top, bottom);
+	});
+	return bands;
+}
+
+TEST(PartialRedrawTest, OnlyChangedRowsAreBlitted)
+{
+	const OwnedSurface current(64, 48);
+	const OwnedSurface presented(64, 48);
+	for (int y = 0; y < 48; y++) {
+		for (int x = 0; x < 64; x++) {
+			current.SetPixel({ x, y }, static_cast<uint8_t>(x + y));
+			presented.SetPixel({ x, y }, static_cast<uint8_t>(x + y));
+		}
+	}
+	EXPECT_TRUE(ChangedRowBands(current, presented, 48).empty());
+
+	current.SetPixel({ 63, 3 }, 0);
+	current.SetPixel({ 0, 6 }, 0);
+	current.SetPixel({ 10, 30 }, 0);
+	current.SetPixel({ 10, 47 }, 0);
+	const std::vector<std::pair<int, int>> expected { { 3, 7 }, { 30, 31 } };
+	EXPECT_EQ(ChangedRowBands(current, presented, 40), expected) << "Nearby rows are joined and rows past the height are ignored";
+}
+
+} // namespace
+} // namespace devilution
@@ -1,13 +1,23 @@
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
+#include <function_ref.hpp>
 #include <utility>
 
+#include "engine/displacement.hpp"
 #include "engine/path.h"
+#include "engine/path_impl.hpp"
 #include "engine/point.hpp"
 #include "engine/points_in_rectangle_range.hpp"
 #include "engine/size.hpp"
+#include "levels/gendung_defs.hpp"
+#include "levels/walkability.hpp"
+#include "utils/paths.h"
 
 namespace devilution {
 namespace {
@@ -154,10 +164,125 @@ void BM_NoPathBig(benchmark::State &state)
 	    state);
 }
 
+/** @brief A set piece from test/fixtures/levels, with the path between its two floor tiles furthest apart. */
+struct LevelMap {
+	Walkability walkability;
+	Point start;
+	Point dest;
+};
+
+/**
+ * @brief Loads a set piece, placed in the dungeon with each megatile covering 2x2 tiles.
+ *
+ * The tileset data is not available here, so a megatile is floor when it is left to the level generator (0) or is the
+ * plain floor megatile of the tileset, and solid otherwise.
+ */
+LevelMap LoadLevelMap(const char *dunPath, uint16_t floorMegatile)
+{
+	const std::string path = paths::BasePath() + "test/fixtures/levels/" + dunPath;
+	std::vector<uint8_t> dun;
+	if (FILE *file = std::fopen(path.c_str(), "rb"); file != nullptr) {
+		uint8_t buffer[4096];
+		size_t read;
+		while ((read = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+			dun.insert(dun.end(), buffer, buffer + read);
+		std::fclose(file);
+	}
+	const auto readLE16 = [&dun](size_t index) { return static_cast<uint16_t>(dun[2 * index] | (dun[2 * index + 1] << 8)); };
+	if (dun.size() < 4 || dun.size() < 2 * (2 + static_cast<size_t>(readLE16(0)) * readLE16(1))) {
+		std::fprintf(stderr, "Failed to read %s\n", path.c_str());
+		exit(1);
+	}
+	const Size size { readLE16(0), readLE16(1) };
+
+	constexpr Displacement Origin { 16, 16 };
+	LevelMap map {};
+	for (int y = 0; y < MAXDUNY; y++) {
+		for (int x = 0; x < MAXDUNX; x++)
+			map.walkability.solid.set(x, y);
+	}
+	for (const Point megatile : PointsInRectangle(Rectangle(Point { 0, 0 }, size))) {
+		const uint16_t id = readLE16(2 + megatile.y * size.width + megatile.x);
+		if (id != 0 && id != floorMegatile)
+			continue;
+		const Point tile = Point { 2 * megatile.x, 2 * megatile.y } + Origin;
+		for (const Point floor : PointsInRectangle(Rectangle(tile, Size { 2, 2 })))
+			map.walkability.solid.reset(floor.x, floor.y);
+	}
+
+	// Breadth-first search through each area of connected floor tiles. In the largest area, the path goes from the
+	// first tile to the last one reached, which is the furthest away.
+	std::vector<bool> visited(MAXDUNX * MAXDUNY);
+	std::vector<Point> queue;
+	size_t largestArea = 0;
+	for (const Point tile : PointsInRectangle(Rectangle(Point { 0, 0 } + Origin, Size { 2 * size.width, 2 * size.height }))) {
+		if (!map.walkability.isTileNotSolid(tile) || visited[tile.y * MAXDUNX + tile.x])
+			continue;
+		queue.assign(1, tile);
+		visited[tile.y * MAXDUNX + tile.x] = true;
+		for (size_t i = 0; i < queue.size(); i++) {
+			for (const Displacement &direction : PathDirs) {
+				const Point next = queue[i] + direction;
+				if (!map.walkability.isTileNotSolid(next) || visited[next.y * MAXDUNX + next.x] || !map.walkability.canStep(queue[i], next))
+					continue;
+				visited[next.y * MAXDUNX + next.x] = true;
+				queue.push_back(next);
+			}
+		}
+		if (queue.size() > largestArea) {
+			largestArea = queue.size();
+			map.start = queue.front();
+			map.dest = queue.back();
+		}
+	}
+	if (largestArea == 0) {
+		std::fprintf(stderr, "%s has no floor\n", path.c_str());
+		exit(1);
+	}
+	return map;
+}
+
+/** @brief Finds the path through the set piece with the `tl::function_ref` overload of `FindPath`. */
+void BM_LevelPath(benchmark::State &state, const char *dunPath, uint16_t floorMegatile)
+{
+	const LevelMap map = LoadLevelMap(dunPath, floorMegatile);
+	const Walkability &walkability = map.walkability;
+	const auto canStep = [&walkability](Point startPosition, Point destinationPosition) { return walkability.canStep(startPosition, destinationPosition); };
+	const auto posOk = [&walkability](Point position) { return walkability.isTileNotSolid(position); };
+	for (auto _ : state) {
+		int8_t path[MaxPathLengthPlayer];
+		const int result = FindPath(tl::function_ref<bool(Point, Point)>(canStep), tl::function_ref<bool(Point)>(posOk),
+		    map.start, map.dest, path, MaxPathLengthPlayer);
+		benchmark::DoNotOptimize(result);
+	}
+}
+
+/** @brief Finds the same path as `BM_LevelPath` with the template overload of `FindPath`. */
+void BM_LevelPathInlined(benchmark::State &state, const char *dunPath, uint16_t floorMegatile)
+{
+	const LevelMap map = LoadLevelMap(dunPath, floorMegatile);
+	const Walkability &walkability = map.walkability;
+	const auto canStep = [&walkability](Point startPosition, Point destinationPosition) { return walkability.canStep(startPosition, destinationPosition); };
+	const auto posOk = [&walkability](Point position) { return walkability.isTileNotSolid(position); };
+	for (auto _ : state) {
+		int8_t path[MaxPathLengthPlayer];
+		const int result = FindPath(canStep, posOk, map.start, map.dest, path, MaxPathLengthPlayer);
+		benchmark::DoNotOptimize(result);
+	}
+}
+
 BENCHMARK(BM_SinglePath);
 BENCHMARK(BM_Bridges);
 BENCHMARK(BM_NoPath);
 BENCHMARK(BM_NoPathBig);
+BENCHMARK_CAPTURE(BM_LevelPath, skngdo, "l1data/skngdo.dun", 13);
+BENCHMARK_CAPTURE(BM_LevelPath, blood1, "l2data/blood1.dun", 3);
+BENCHMARK_CAPTURE(BM_LevelPath, anvil, "l3data/anvil.dun", 7);
+BENCHMARK_CAPTURE(BM_LevelPath, diab2a, "l4data/diab2a.dun", 6);
+BENCHMARK_CAPTURE(BM_LevelPathInlined, skngdo, "l1data/skngdo.dun", 13);
+BENCHMARK_CAPTURE(BM_LevelPathInlined, blood1, "l2data/blood1.dun", 3);
+BENCHMARK_CAPTURE(BM_LevelPathInlined, anvil, "l3data/anvil.dun", 7);
+BENCHMARK_CAPTURE(BM_LevelPathInlined, diab2a, "l4data/diab2a.dun", 6);
 
 } // namespace
 } // namespace devilution
@@ -4,7 +4,11 @@
 
 #include "cursor.h"
 #include "engine/assets.hpp"
+#include "engine/path.h"
 #include "init.hpp"
+#include "level_test.hpp"
+#include "levels/gendung.h"
+#include "options.h"
 #include "playerdat.hpp"
 
 using namespace devilution;
@@ -196,3 +200,47 @@ TEST(Player, CreatePlayer)
 	CreatePlayer(Players[0], HeroClass::Rogue);
 	AssertPlayer(Players[0]);
 }
+
+TEST(Player, WalksToDestinationBeyondMaxPathLength)
+{
+	LoadCoreArchives();
+	LoadGameArchives();
+
+	// The tests need spawn.mpq or diabdat.mpq
+	// Please provide them so that the tests can run successfully
+	ASSERT_TRUE(HaveMainData());
+
+	LoadPlayerDataFiles();
+	LoadMonsterData();
+	LoadItemData();
+	GetOptions().Audio.walkingSound.SetValue(false);
+
+	InitWindingCorridor(3);
+	leveltype = DTYPE_TOWN;
+	currlevel = 0;
+
+	Players.resize(1);
+	MyPlayer = &Players[0];
+	Player &player = Players[0];
+	CreatePlayer(player, HeroClass::Warrior);
+	player.plractive = true;
+	player.plrlevel = 0;
+	player.position.tile = { 1, 2 };
+	player.position.future = player.position.tile;
+	SetPlrAnims(player);
+	StartStand(player, Direction::South);
+
+	const Point destination { 1, 6 };
+	MakePlrWalkPath(player, destination);
+	ASSERT_NE(player.walkpath[0], WALK_NONE);
+	ASSERT_TRUE(player.walkDestination.has_value()) << "The destination is more than MaxPathLengthPlayer steps away";
+	EXPECT_EQ(*player.walkDestination, destination);
+
+	for (int tick = 0; tick < 5000 && (player.position.tile != destination || player._pmode != PM_STAND); tick++)
+		ProcessPlayers();
+	EXPECT_EQ(player.position.tile, destination);
+	EXPECT_EQ(player._pmode, PM_STAND);
+	EXPECT_FALSE(player.walkDestination.has_value());
+
+	ClearLevel();
+}
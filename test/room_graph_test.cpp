@@ -0,0 +1,48 @@
+#include "levels/room_graph.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "engine/point.hpp"
+#include "level_test.hpp"
+#include "levels/gendung.h"
+
+namespace devilution {
+namespace {
+
+TEST(RoomGraphTest, RouteFollowsWindingCorridor)
+{
+	InitWindingCorridor(6);
+	const Point start { 1, 2 };
+	const Point destination { 1, 12 };
+	std::vector<RouteWaypoint> route;
+	ASSERT_TRUE(FindRoomRoute(start, destination, route));
+
+	ASSERT_FALSE(route.empty());
+	EXPECT_EQ(route.back().position, destination);
+	// Each lane is walked from end to end, and each bend takes two steps.
+	EXPECT_EQ(route.back().steps, 6U * (MAXDUNX - 3) + 5U * 2);
+	for (size_t i = 1; i < route.size(); i++) {
+		EXPECT_LT(route[i - 1].steps, route[i].steps);
+		EXPECT_LE(route[i].steps - route[i - 1].steps, 2U * 16) << "Waypoints are at most a room apart";
+	}
+	ClearLevel();
+}
+
+TEST(RoomGraphTest, NoRouteWithinRoomOrToWalledOffTile)
+{
+	InitWindingCorridor(2);
+	std::vector<RouteWaypoint> route;
+	EXPECT_FALSE(FindRoomRoute({ 1, 2 }, { 3, 2 }, route)) << "No route is needed within a room";
+	EXPECT_TRUE(route.empty());
+
+	dPiece[50][8] = FloorPiece;
+	InvalidateRoomGraph();
+	EXPECT_FALSE(FindRoomRoute({ 1, 2 }, { 50, 8 }, route)) << "A walled off tile cannot be reached";
+	EXPECT_FALSE(FindRoomRoute({ 1, 2 }, { 50, 7 }, route)) << "A wall cannot be reached";
+	ClearLevel();
+}
+
+} // namespace
+} // namespace devilution
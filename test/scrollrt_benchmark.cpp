@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "control.h"
+#include "engine/assets.hpp"
+#include "engine/displacement.hpp"
+#include "engine/lighting_defs.hpp"
+#include "engine/load_file.hpp"
+#include "engine/point.hpp"
+#include "engine/render/scrollrt.h"
+#include "engine/surface.hpp"
+#include "levels/dun_tile.hpp"
+#include "levels/gendung.h"
+#include "lighting.h"
+#include "options.h"
+#include "player.h"
+#include "utils/log.hpp"
+#include "utils/sdl_wrap.h"
+#include "utils/ui_fwd.h"
+
+namespace devilution {
+namespace {
+
+constexpr Point ViewCenter { 40, 40 };
+constexpr Point MovingLightStart { 42, 38 };
+
+SDLSurfaceUniquePtr SdlSurface;
+int MovingLight;
+
+/**
+ * @brief Finds a piece that is drawn as a plain floor tile, or one that is drawn as a wall when looking for a wall.
+ */
+uint16_t FindPiece(bool wall)
+{
+	for (uint16_t i = 0; i < MAXTILES; i++) {
+		const MICROS &micros = DPieceMicros[i];
+		if (!micros.mt[0].hasValue() || !micros.mt[1].hasValue())
+			continue;
+		const bool solid = HasAnyOf(SOLData[i], TileProperties::Solid | TileProperties::BlockMissile);
+		if (solid == wall && micros.mt[2].hasValue() == wall)
+			return i;
+	}
+	LogError("No {} piece found in the cathedral tileset", wall ? "wall" : "floor");
+	exit(1);
+}
+
+/**
+ * @brief Builds a cathedral level of small rooms with a few lights, then lays out a 640x480 screen around its center.
+ */
+void InitOnce()
+{
+	[[maybe_unused]] static const bool GlobalInitDone = []() {
+		LoadCoreArchives();
+		LoadGameArchives();
+		if (!HaveMainData()) {
+			LogError("This benchmark needs spawn.mpq or diabdat.mpq");
+			exit(1);
+		}
+
+		gnScreenWidth = 640;
+		gnScreenHeight = 480;
+		gnViewportHeight = gnScreenHeight - 128;
+		GetOptions().Graphics.zoom.SetValue(false);
+		CalculatePanelAreas();
+		CalcViewportGeometry();
+
+		Players.resize(1);
+		MyPlayer = &Players[0];
+
+		leveltype = DTYPE_CATHEDRAL;
+		currlevel = 1;
+		if (const tl::expected<void, std::string> result = LoadLevelSOLData(); !result.has_value()) {
+			LogError("{}", result.error());
+			exit(1);
+		}
+		pDungeonCels = LoadFileInMem("levels\\l1data\\l1.cel");
+		SetDungeonMicros(pDungeonCels, MicroTileLen);
+		MakeLightTable();
+
+		const uint16_t floor = FindPiece(/*wall=*/false);
+		const uint16_t wall = FindPiece(/*wall=*/true);
+		for (int x = 0; x < MAXDUNX; x++) {
+			for (int y = 0; y < MAXDUNY; y++) {
+				const bool isWall = (x % 8 == 0 && y % 8 > 2) || (y % 8 == 0 && x % 8 > 2);
+				dPiece[x][y] = isWall ? wall : floor;
+			}
+		}
+
+		InitLighting();
+		memset(dPreLight, LightsMax, sizeof(dPreLight));
+		memcpy(dLight, dPreLight, sizeof(dLight));
+		AddLight(ViewCenter, 10);
+		AddLight(ViewCenter + Displacement { -5, 4 }, 5);
+		MovingLight = AddLight(MovingLightStart, 3);
+		UpdateLighting = true;
+		ProcessLightList();
+
+		SdlSurface = SDLWrap::CreateRGBSurfaceWithFormat(
+		    /*flags=*/0, gnScreenWidth, gnScreenHeight, /*depth=*/8, SDL_PIXELFORMAT_INDEX8);
+		if (SdlSurface == nullptr) {
+			LogError("Failed to create SDL Surface: {}", SDL_GetError());
+			exit(1);
+		}
+		return true;
+	}();
+}
+
+/**
+ * @param state Range 0 is whether a light next to the player moves back and forth every frame
+ */
+void RunDrawDungeonView(benchmark::State &state, bool floorCache)
+{
+	InitOnce();
+	GetOptions().Graphics.floorCache.SetValue(floorCache);
+	const bool moveLight = state.range(0) != 0;
+	const Surface out = Surface(SdlSurface.get());
+	bool forward = true;
+	for (auto _ : state) {
+		if (moveLight) {
+			ChangeLightXY(MovingLight, MovingLightStart + Displacement { forward ? 1 : 0, 0 });
+			forward = !forward;
+			ProcessLightList();
+		}
+		DrawDungeonView(out, ViewCenter);
+		uint8_t color = out[Point { 320, 176 }];
+		benchmark::DoNotOptimize(color);
+	}
+}
+
+void BM_DrawDungeonView(benchmark::State &state)
+{
+	RunDrawDungeonView(state, /*floorCache=*/false);
+}
+
+void BM_DrawDungeonViewFloorCache(benchmark::State &state)
+{
+	RunDrawDungeonView(state, /*floorCache=*/true);
+}
+
+BENCHMARK(BM_DrawDungeonView)->Arg(0)->Arg(1);
+BENCHMARK(BM_DrawDungeonViewFloorCache)->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace devilution
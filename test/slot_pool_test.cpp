@@ -0,0 +1,89 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/slot_pool.hpp"
+
+using namespace devilution;
+
+namespace {
+
+constexpr size_t BlockSize = 4;
+
+std::vector<int> ToVector(const SlotPool<int, BlockSize> &pool)
+{
+	return { pool.begin(), pool.end() };
+}
+
+TEST(SlotPool, KeepsInsertionOrder)
+{
+	SlotPool<int, BlockSize> pool;
+	for (int i = 0; i < 10; i++)
+		pool.emplace_back(i);
+
+	EXPECT_EQ(pool.size(), 10U);
+	EXPECT_EQ(pool.front(), 0);
+	EXPECT_EQ(pool.back(), 9);
+	EXPECT_EQ(ToVector(pool), (std::vector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST(SlotPool, RemoveIfKeepsOrderOfOthers)
+{
+	SlotPool<int, BlockSize> pool;
+	for (int i = 0; i < 10; i++)
+		pool.emplace_back(i);
+
+	EXPECT_EQ(pool.remove_if([](int value) { return value % 3 == 0; }), 4U);
+	EXPECT_EQ(ToVector(pool), (std::vector<int> { 1, 2, 4, 5, 7, 8 }));
+	EXPECT_EQ(pool.front(), 1);
+	EXPECT_EQ(pool.back(), 8);
+}
+
+TEST(SlotPool, ReusesFreedSlots)
+{
+	SlotPool<int, BlockSize> pool;
+	for (int i = 0; i < 8; i++)
+		pool.emplace_back(i);
+	const size_t capacity = pool.capacity();
+
+	pool.remove_if([](int value) { return value < 4; });
+	for (int i = 8; i < 12; i++)
+		pool.emplace_back(i);
+
+	EXPECT_EQ(pool.capacity(), capacity);
+	EXPECT_EQ(ToVector(pool), (std::vector<int> { 4, 5, 6, 7, 8, 9, 10, 11 }));
+
+	pool.clear();
+	EXPECT_TRUE(pool.empty());
+	EXPECT_TRUE(pool.begin() == pool.end());
+	pool.emplace_back(42);
+	EXPECT_EQ(pool.capacity(), capacity);
+	EXPECT_EQ(ToVector(pool), (std::vector<int> { 42 }));
+}
+
+TEST(SlotPool, ElementsDoNotMove)
+{
+	SlotPool<int, BlockSize> pool;
+	const int *first = &pool.emplace_back(0);
+	for (int i = 1; i < 100; i++)
+		pool.emplace_back(i);
+
+	EXPECT_EQ(first, &pool.front());
+	EXPECT_EQ(*first, 0);
+}
+
+TEST(SlotPool, VisitsElementsAppendedWhileIterating)
+{
+	SlotPool<int, BlockSize> pool;
+	pool.emplace_back(0);
+	int visited = 0;
+	for (const int value : pool) {
+		if (value < 9)
+			pool.emplace_back(value + 1);
+		visited++;
+	}
+
+	EXPECT_EQ(visited, 10);
+}
+
+} // namespace
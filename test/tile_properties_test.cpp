@@ -3,8 +3,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "engine/displacement.hpp"
+#include "engine/path.h"
+#include "engine/point.hpp"
 #include "levels/dun_tile.hpp"
 #include "levels/gendung.h"
+#include "levels/walkability.hpp"
 #include "objdat.h"
 #include "objects.h"
 
@@ -99,5 +103,44 @@ TEST(TilePropertiesTest, CanStepTest)
 	dPiece[1][1] = 0;
 }
 
+TEST(TilePropertiesTest, WalkabilityMatchesTileChecks)
+{
+	SOLData[0] = TileProperties::None;
+	SOLData[1] = TileProperties::Solid;
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4; y++)
+			dPiece[x][y] = (x + 2 * y) % 3 == 0 ? 1 : 0;
+	}
+	dMonster[2][1] = 1;
+	InvalidateWalkability();
+	const Walkability &walkability = GetWalkability();
+
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4; y++) {
+			const Point position { x, y };
+			EXPECT_EQ(walkability.isTileNotSolid(position), IsTileNotSolid(position)) << "at " << x << ", " << y;
+			for (const Displacement &direction : PathDirs) {
+				EXPECT_EQ(walkability.canStep(position, position + direction), CanStep(position, position + direction))
+				    << "from " << x << ", " << y;
+			}
+		}
+	}
+	EXPECT_FALSE(walkability.isTileVacant({ 2, 1 })) << "A tile with a monster is not vacant";
+	EXPECT_TRUE(walkability.isTileVacant({ 1, 2 })) << "An empty tile is vacant";
+	EXPECT_FALSE(walkability.isTileVacant({ -1, 0 })) << "A tile outside of the dungeon is not vacant";
+
+	dMonster[2][1] = 0;
+	MarkTileOccupied({ 1, 2 });
+	EXPECT_FALSE(GetWalkability().isTileVacant({ 1, 2 })) << "A tile is no longer vacant once something moves onto it";
+	InvalidateOccupiedTiles();
+	EXPECT_TRUE(GetWalkability().isTileVacant({ 2, 1 })) << "Vacated tiles are forgotten once the occupied tiles are rebuilt";
+
+	for (int x = 0; x < 4; x++) {
+		for (int y = 0; y < 4; y++)
+			dPiece[x][y] = 0;
+	}
+	InvalidateWalkability();
+}
+
 } // namespace
 } // namespace devilution
@@ -1,6 +1,8 @@
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <sstream>
 
 #include "engine/assets.hpp"
 #include "engine/demomode.h"
@@ -67,6 +69,8 @@ void RunTimedemo(std::string timedemoFolderName)
 	gbSoundOn = false;
 	HeadlessMode = true;
 	demo::InitPlayBack(demoNumber, true);
+	const std::filesystem::path timingLogPath = std::filesystem::temp_directory_path() / ("timedemo_" + timedemoFolderName + ".json");
+	demo::InitTimingLog(timingLogPath.string());
 
 	LoadSpellData();
 	LoadPlayerDataFiles();
@@ -86,6 +90,15 @@ void RunTimedemo(std::string timedemoFolderName)
 	const HeroCompareResult result = pfile_compare_hero_demo(demoNumber, true);
 	ASSERT_EQ(result.status, HeroCompareResult::Same) << result.message;
 	ASSERT_FALSE(gbRunGame);
+
+	std::ifstream timingLog(timingLogPath);
+	ASSERT_TRUE(timingLog.is_open());
+	std::stringstream timingLogContents;
+	timingLogContents << timingLog.rdbuf();
+	EXPECT_NE(timingLogContents.str().find("\"logic\": { \"mean\""), std::string::npos);
+	EXPECT_NE(timingLogContents.str().find("\"frameTimes\": [\n    ["), std::string::npos);
+	timingLog.close();
+	std::filesystem::remove(timingLogPath);
 	gbRunGame = false;
 	init_cleanup();
 	LuaShutdown();
@@ -0,0 +1,61 @@
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "engine/point.hpp"
+#include "vision.hpp"
+
+namespace devilution {
+namespace {
+
+constexpr int EnvSize = 40;
+constexpr Point Observer { EnvSize / 2, EnvSize / 2 };
+
+using Environment = std::array<std::array<bool, EnvSize>, EnvSize>;
+
+/** @brief An open area with a pillar every few tiles, similar to a large cathedral hall. */
+Environment MakePillarHall()
+{
+	Environment blocked {};
+	for (int x = 2; x < EnvSize; x += 4) {
+		for (int y = 2; y < EnvSize; y += 4) {
+			if (Point { x, y } != Observer)
+				blocked[x][y] = true;
+		}
+	}
+	return blocked;
+}
+
+void RunVision(benchmark::State &state, const Environment &blocked)
+{
+	const auto radius = static_cast<uint8_t>(state.range(0));
+	int visibleTiles = 0;
+	for (auto _ : state) {
+		DoVision(
+		    Observer, radius,
+		    [&visibleTiles](Point) { visibleTiles++; },
+		    [](Point) {},
+		    [&blocked](Point p) { return !blocked[p.x][p.y]; },
+		    [](Point p) { return p.x >= 0 && p.y >= 0 && p.x < EnvSize && p.y < EnvSize; });
+		benchmark::DoNotOptimize(visibleTiles);
+	}
+}
+
+void BM_VisionOpen(benchmark::State &state)
+{
+	const Environment blocked {};
+	RunVision(state, blocked);
+}
+
+void BM_VisionPillarHall(benchmark::State &state)
+{
+	const Environment blocked = MakePillarHall();
+	RunVision(state, blocked);
+}
+
+BENCHMARK(BM_VisionOpen)->Arg(4)->Arg(10)->Arg(15);
+BENCHMARK(BM_VisionPillarHall)->Arg(4)->Arg(10)->Arg(15);
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,99 @@
+#include "levels/walkability.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "engine/path.h"
+#include "engine/point.hpp"
+#include "level_test.hpp"
+#include "levels/gendung.h"
+#include "monster.h"
+#include "objects.h"
+#include "player.h"
+
+namespace devilution {
+namespace {
+
+constexpr Point Start { 40, 40 };
+
+/** @brief Builds a level with scattered pillars, a living and a dead monster, another player and two objects. */
+void InitLevel()
+{
+	FillLevel(FloorPiece);
+	for (int x = 0; x < MAXDUNX; x++) {
+		for (int y = 0; y < MAXDUNY; y++) {
+			if ((x * 7 + y * 13) % 11 == 0)
+				dPiece[x][y] = WallPiece;
+		}
+	}
+	dPiece[Start.x][Start.y] = FloorPiece;
+
+	leveltype = DTYPE_CATHEDRAL;
+	Players.resize(2);
+	MyPlayer = &Players[0];
+	MyPlayer->position.tile = Start;
+	MyPlayer->position.future = Start;
+	dPlayer[Start.x][Start.y] = 1;
+	Players[1]._pHitPoints = 64;
+	dPlayer[40][43] = 2;
+
+	Monsters[0].hitPoints = 1 << 6;
+	dMonster[42][40] = 1;
+	Monsters[1].hitPoints = 0;
+	dMonster[38][40] = 2;
+
+	Objects[0]._otype = _object_id::OBJ_BARREL;
+	Objects[0]._oSolidFlag = true;
+	dObject[44][44] = 1;
+	Objects[1]._otype = _object_id::OBJ_BARREL;
+	Objects[1]._oSolidFlag = false;
+	dObject[36][36] = 2;
+
+	InvalidateLevelLayout();
+}
+
+/** @brief Expects `FindPlayerPath` to find the same paths as `FindPath` with the checks that read the level directly. */
+void ExpectSamePaths()
+{
+	const Player &player = *MyPlayer;
+	for (int x = 20; x < 60; x++) {
+		for (int y = 20; y < 60; y++) {
+			const Point destination { x, y };
+			int8_t expectedPath[MaxPathLengthPlayer];
+			const int expectedLength = FindPath(
+			    CanStep, [&player](Point position) { return PosOkPlayer(player, position); },
+			    Start, destination, expectedPath, MaxPathLengthPlayer);
+			int8_t path[MaxPathLengthPlayer];
+			const int length = FindPlayerPath(player, destination, path, MaxPathLengthPlayer);
+			ASSERT_EQ(length, expectedLength) << "Path length to " << destination;
+			EXPECT_TRUE(std::equal(path, path + length, expectedPath)) << "Path to " << destination;
+		}
+	}
+}
+
+TEST(WalkabilityTest, FindsSamePathsAsLevelChecks)
+{
+	InitLevel();
+	ExpectSamePaths();
+	ClearLevel();
+}
+
+TEST(WalkabilityTest, FindsSamePathsAfterLayoutChange)
+{
+	InitLevel();
+	ExpectSamePaths();
+
+	// Like a door closing or a town area opening up while the level is played.
+	for (int x = 30; x < 50; x++)
+		dPiece[x][45] = WallPiece;
+	dPiece[43][42] = FloorPiece;
+	InvalidateLevelLayout();
+	ExpectSamePaths();
+
+	ClearLevel();
+}
+
+} // namespace
+} // namespace devilution
@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+
+import argparse
+import json
+import pathlib
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+
+_DEMO_FILE_REGEX = re.compile(r'demo_(\d+)\.dmo')
+
+# Metrics of the timing log written by `--timedemo-log`, compared against the baseline.
+_METRICS = [(section, stat) for section in ('logic', 'render', 'total') for stat in ('mean', 'p50', 'p99')]
+
+
+def find_demos(fixtures_dir: pathlib.Path) -> list[tuple[pathlib.Path, int]]:
+	demos = []
+	for fixture in sorted(p for p in fixtures_dir.iterdir() if p.is_dir()):
+		for demo_file in sorted(fixture.glob('demo_*.dmo')):
+			match = _DEMO_FILE_REGEX.fullmatch(demo_file.name)
+			if match:
+				demos.append((fixture, int(match.group(1))))
+	return demos
+
+
+def measure(binary: str, fixture: pathlib.Path, demo_number: int) -> dict:
+	# The game writes to its save and config directories, so play the demo from a copy of the fixture.
+	with tempfile.TemporaryDirectory() as tmp:
+		save_dir = pathlib.Path(tmp) / fixture.name
+		shutil.copytree(fixture, save_dir)
+		timing_log = pathlib.Path(tmp) / 'timing.json'
+		result: subprocess.CompletedProcess = subprocess.run(
+			[binary, '--diablo', '--spawn', '--lang', 'en', '--save-dir', str(save_dir), '--config-dir', str(save_dir),
+			 '--demo', str(demo_number), '--timedemo', '--timedemo-log', str(timing_log)], capture_output=True)
+		if result.returncode != 0 or not timing_log.exists():
+			raise Exception(f"Failed to play {fixture.name} demo {demo_number}:\n{result.stderr.decode(errors='replace')}")
+		with timing_log.open() as f:
+			log = json.load(f)
+	return {f'{section}.{stat}': log[section][stat] for section, stat in _METRICS} | {'frames': log['frames']}
+
+
+def main():
+	parser = argparse.ArgumentParser(
+		description='Plays every timedemo fixture and compares the frame times against a baseline.')
+	parser.add_argument('--binary', help='Path to the devilutionx binary', required=True)
+	parser.add_argument('--baseline', help='Path to the baseline JSON file', required=True)
+	parser.add_argument('--update-baseline', action='store_true', help='Write the measurements to the baseline instead of comparing')
+	parser.add_argument('--fixtures', default='test/fixtures/timedemo', help='Directory of the timedemo fixtures')
+	parser.add_argument('-n', '--num-runs', type=int, default=5, metavar='N')
+	parser.add_argument('-t', '--threshold', type=float, default=10.0, metavar='PERCENT',
+		help='Fail if a metric is slower than the baseline by more than this')
+	args = parser.parse_args()
+
+	demos = find_demos(pathlib.Path(args.fixtures))
+	if not demos:
+		print(f"No demos found in {args.fixtures}", file=sys.stderr)
+		sys.exit(1)
+
+	results = {}
+	for fixture, demo_number in demos:
+		name = f'{fixture.name}/demo_{demo_number}'
+		runs = []
+		for i in range(1, args.num_runs + 1):
+			print(f"{name}: run {i:>2} of {args.num_runs}", file=sys.stderr, flush=True)
+			runs.append(measure(args.binary, fixture, demo_number))
+		# The median is less sensitive than the mean to an occasional slow run.
+		results[name] = {key: statistics.median(run[key] for run in runs) for key in runs[0]}
+
+	baseline_path = pathlib.Path(args.baseline)
+	if args.update_baseline:
+		with baseline_path.open('w') as f:
+			json.dump(results, f, indent='\t', sort_keys=True)
+			f.write('\n')
+		print(f"Wrote {baseline_path}")
+		return
+
+	with baseline_path.open() as f:
+		baseline = json.load(f)
+
+	regressions = 0
+	for name, metrics in results.items():
+		if name not in baseline:
+			print(f"{name}: not in the baseline, skipped")
+			continue
+		if metrics['frames'] != baseline[name]['frames']:
+			print(f"{name}: played {metrics['frames']} frames, the baseline has {baseline[name]['frames']}")
+			regressions += 1
+			continue
+		for section, stat in _METRICS:
+			key = f'{section}.{stat}'
+			current, reference = metrics[key], baseline[name][key]
+			change = (current - reference) * 100 / reference if reference > 0 else 0.0
+			failed = change > args.threshold
+			if failed:
+				regressions += 1
+			print(f"{name}: {key:<12} {reference / 1000:>8.3f} ms -> {current / 1000:>8.3f} ms {change:>+7.1f}%{'  REGRESSION' if failed else ''}")
+
+	if regressions > 0:
+		print(f"{regressions} regression(s) beyond {args.threshold}%", file=sys.stderr)
+		sys.exit(1)
+
+
+main()